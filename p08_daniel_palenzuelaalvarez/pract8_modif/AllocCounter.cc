@@ -0,0 +1,50 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: AllocCounter.cc: Contadores de reservas de memoria dinámica.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file AllocCounter.cc
+ * @brief Contadores globales compartidos por el ejecutable normal y el instrumentado.
+ */
+
+#include "AllocCounter.h"
+
+#include <atomic>
+
+namespace {
+
+// Inicialización constante: válidos aunque se reserve memoria antes de main()
+std::atomic<bool> enabled(false);
+std::atomic<uint64_t> allocations(0);
+std::atomic<uint64_t> bytes(0);
+
+} // namespace
+
+AllocCounts CurrentAllocCounts() {
+    AllocCounts counts;
+    counts.allocations = allocations.load(std::memory_order_relaxed);
+    counts.bytes = bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+bool AllocCountingEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+void EnableAllocCounting() noexcept { enabled.store(true, std::memory_order_relaxed); }
+
+void RecordAllocation(size_t size) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+}
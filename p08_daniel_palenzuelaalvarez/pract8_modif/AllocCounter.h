@@ -0,0 +1,62 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: AllocCounter.h: Contadores de reservas de memoria dinámica.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file AllocCounter.h
+ * @brief Número de reservas y bytes pedidos a operator new por todo el programa.
+ *
+ * Los contadores solo avanzan en el ejecutable instrumentado (make alloc),
+ * que enlaza además AllocHooks.cc con los operator new/delete globales
+ * sustituidos. En el ejecutable normal AllocCountingEnabled() es false y
+ * los contadores se quedan a cero.
+ */
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Reservas acumuladas desde el inicio del programa.
+ */
+struct AllocCounts {
+    uint64_t allocations = 0; // llamadas a operator new (de cualquier forma)
+    uint64_t bytes = 0;       // bytes pedidos en esas llamadas
+};
+
+/**
+ * @brief Valores actuales de los contadores (de todos los hilos).
+ */
+AllocCounts CurrentAllocCounts();
+
+/**
+ * @brief Indica si el ejecutable tiene los operator new/delete instrumentados.
+ */
+bool AllocCountingEnabled();
+
+/**
+ * @brief Activa el recuento; lo llama AllocHooks.cc al iniciarse.
+ */
+void EnableAllocCounting() noexcept;
+
+/**
+ * @brief Anota una reserva de bytes; lo llaman los operator new de AllocHooks.cc.
+ */
+void RecordAllocation(size_t bytes) noexcept;
+
+#endif
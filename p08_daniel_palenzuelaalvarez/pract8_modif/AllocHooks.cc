@@ -0,0 +1,63 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: AllocHooks.cc: operator new/delete globales que cuentan las reservas.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file AllocHooks.cc
+ * @brief Sustitución de los operator new/delete globales (solo en make alloc).
+ *
+ * Se sustituyen las formas básica y alineada; las de vector y las nothrow
+ * de la biblioteca estándar llaman a estas, así que también se cuentan.
+ * La memoria se pide a malloc/aligned_alloc y se libera con free.
+ */
+
+#include "AllocCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+const bool kEnabled = (EnableAllocCounting(), true);
+
+void* Allocate(std::size_t size, std::size_t align) {
+    RecordAllocation(size);
+    if (size == 0) size = 1;
+    if (align > alignof(std::max_align_t)) size = (size + align - 1) / align * align;
+    for (;;) {
+        void* p = align > alignof(std::max_align_t) ? std::aligned_alloc(align, size) : std::malloc(size);
+        if (p) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return Allocate(size, alignof(std::max_align_t)); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return Allocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,156 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: BigUnsigned.cc: Implementación de los enteros de precisión arbitraria.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file BigUnsigned.cc
+ * @brief Implementación de BigUnsigned.
+ */
+
+#include "BigUnsigned.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+BigUnsigned::BigUnsigned(uint64_t v) {
+    while (v != 0) {
+        limbs_.push_back(static_cast<uint32_t>(v));
+        v >>= 32;
+    }
+}
+
+void BigUnsigned::Trim() {
+    while (!limbs_.empty() && limbs_.back() == 0) limbs_.pop_back();
+}
+
+BigUnsigned& BigUnsigned::operator+=(const BigUnsigned& o) {
+    if (limbs_.size() < o.limbs_.size()) limbs_.resize(o.limbs_.size(), 0);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs_.size(); ++i) {
+        uint64_t s = carry + limbs_[i] + (i < o.limbs_.size() ? o.limbs_[i] : 0);
+        limbs_[i] = static_cast<uint32_t>(s);
+        carry = s >> 32;
+        // Sin acarreo y sin más palabras de o: el resto no cambia
+        if (carry == 0 && i >= o.limbs_.size()) break;
+    }
+    if (carry) limbs_.push_back(static_cast<uint32_t>(carry));
+    return *this;
+}
+
+BigUnsigned& BigUnsigned::operator-=(const BigUnsigned& o) {
+    if (Compare(o) < 0) throw std::underflow_error("BigUnsigned: resta con resultado negativo.");
+    int64_t borrow = 0;
+    for (size_t i = 0; i < limbs_.size(); ++i) {
+        int64_t d = static_cast<int64_t>(limbs_[i]) - borrow - (i < o.limbs_.size() ? o.limbs_[i] : 0);
+        borrow = d < 0 ? 1 : 0;
+        if (d < 0) d += (int64_t(1) << 32);
+        limbs_[i] = static_cast<uint32_t>(d);
+        if (borrow == 0 && i >= o.limbs_.size()) break;
+    }
+    Trim();
+    return *this;
+}
+
+BigUnsigned BigUnsigned::operator*(const BigUnsigned& o) const {
+    BigUnsigned r;
+    r.AddProduct(*this, o);
+    return r;
+}
+
+void BigUnsigned::AddProduct(const BigUnsigned& a, const BigUnsigned& b) {
+    if (a.IsZero() || b.IsZero()) return;
+    size_t need = a.limbs_.size() + b.limbs_.size() + 1;
+    if (limbs_.size() < need) limbs_.resize(need, 0);
+    // Multiplicación escolar acumulando directamente sobre el propio valor
+    for (size_t i = 0; i < a.limbs_.size(); ++i) {
+        uint64_t carry = 0;
+        uint64_t ai = a.limbs_[i];
+        size_t j = 0;
+        for (; j < b.limbs_.size(); ++j) {
+            uint64_t cur = limbs_[i + j] + ai * b.limbs_[j] + carry;
+            limbs_[i + j] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+        // Propagar el acarreo restante
+        for (size_t k = i + j; carry != 0; ++k) {
+            if (k == limbs_.size()) limbs_.push_back(0);
+            uint64_t cur = limbs_[k] + carry;
+            limbs_[k] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+    }
+    Trim();
+}
+
+uint64_t BigUnsigned::Mod(uint64_t m) const {
+    if (m == 0 || m > 0xffffffffULL) throw std::invalid_argument("BigUnsigned: el módulo debe estar en [1, 2^32).");
+    uint64_t rem = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+        rem = ((rem << 32) | limbs_[i]) % m;
+    }
+    return rem;
+}
+
+int BigUnsigned::Compare(const BigUnsigned& o) const {
+    if (limbs_.size() != o.limbs_.size()) return limbs_.size() < o.limbs_.size() ? -1 : 1;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+        if (limbs_[i] != o.limbs_[i]) return limbs_[i] < o.limbs_[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+bool BigUnsigned::IsZero() const { return limbs_.empty(); }
+
+size_t BigUnsigned::BitLength() const {
+    if (limbs_.empty()) return 0;
+    size_t bits = (limbs_.size() - 1) * 32;
+    uint32_t top = limbs_.back();
+    while (top != 0) { ++bits; top >>= 1; }
+    return bits;
+}
+
+std::string BigUnsigned::ToString() const {
+    if (limbs_.empty()) return "0";
+    // Dividir repetidamente por 10^9 y concatenar los restos
+    std::vector<uint32_t> cur = limbs_;
+    std::vector<uint32_t> chunks;
+    while (!cur.empty()) {
+        uint64_t rem = 0;
+        for (size_t i = cur.size(); i-- > 0;) {
+            uint64_t v = (rem << 32) | cur[i];
+            cur[i] = static_cast<uint32_t>(v / 1000000000u);
+            rem = v % 1000000000u;
+        }
+        while (!cur.empty() && cur.back() == 0) cur.pop_back();
+        chunks.push_back(static_cast<uint32_t>(rem));
+    }
+    std::string out = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string part = std::to_string(chunks[i]);
+        out += std::string(9 - part.size(), '0') + part;
+    }
+    return out;
+}
+
+const std::vector<uint32_t>& BigUnsigned::Limbs() const { return limbs_; }
+
+BigUnsigned BigUnsigned::FromLimbs(std::vector<uint32_t> limbs) {
+    BigUnsigned r;
+    r.limbs_ = std::move(limbs);
+    r.Trim();
+    return r;
+}
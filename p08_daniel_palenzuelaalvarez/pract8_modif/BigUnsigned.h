@@ -0,0 +1,115 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: BigUnsigned.h: Enteros sin signo de precisión arbitraria.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file BigUnsigned.h
+ * @brief Entero sin signo de precisión arbitraria con las operaciones
+ *        necesarias para contar derivaciones (suma, producto, comparación).
+ */
+
+#ifndef BIG_UNSIGNED_H
+#define BIG_UNSIGNED_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class BigUnsigned
+ * @brief Entero sin signo almacenado en palabras de 32 bits (menos significativa primero).
+ *
+ * El valor cero se representa con el vector de palabras vacío.
+ */
+class BigUnsigned {
+public:
+    /**
+     * @brief Construye el valor v (0 por defecto).
+     */
+    BigUnsigned(uint64_t v = 0);
+
+    /**
+     * @brief Suma o en el propio valor.
+     */
+    BigUnsigned& operator+=(const BigUnsigned& o);
+
+    /**
+     * @brief Resta o del propio valor. Precondición: *this >= o.
+     * @throws std::underflow_error Si o es mayor que el valor actual.
+     */
+    BigUnsigned& operator-=(const BigUnsigned& o);
+
+    /**
+     * @brief Producto de dos valores.
+     */
+    BigUnsigned operator*(const BigUnsigned& o) const;
+
+    /**
+     * @brief Suma a * b al propio valor sin crear temporales intermedios.
+     */
+    void AddProduct(const BigUnsigned& a, const BigUnsigned& b);
+
+    /**
+     * @brief Resto de la división por m.
+     * @param m Módulo, con 0 < m < 2^32.
+     * @return valor mod m.
+     */
+    uint64_t Mod(uint64_t m) const;
+
+    /**
+     * @brief Compara con o.
+     * @return negativo, 0 o positivo según *this sea menor, igual o mayor que o.
+     */
+    int Compare(const BigUnsigned& o) const;
+
+    bool operator<(const BigUnsigned& o) const { return Compare(o) < 0; }
+    bool operator==(const BigUnsigned& o) const { return Compare(o) == 0; }
+
+    /**
+     * @brief Indica si el valor es cero.
+     */
+    bool IsZero() const;
+
+    /**
+     * @brief Número de bits significativos (0 para el valor cero).
+     */
+    size_t BitLength() const;
+
+    /**
+     * @brief Representación decimal del valor.
+     */
+    std::string ToString() const;
+
+    /**
+     * @brief Palabras de 32 bits del valor (menos significativa primero).
+     */
+    const std::vector<uint32_t>& Limbs() const;
+
+    /**
+     * @brief Construye un valor a partir de sus palabras de 32 bits.
+     */
+    static BigUnsigned FromLimbs(std::vector<uint32_t> limbs);
+
+private:
+    std::vector<uint32_t> limbs_; // palabras, menos significativa primero
+
+    /**
+     * @brief Elimina las palabras nulas más significativas.
+     */
+    void Trim();
+};
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CYK.cc: Implementación del índice FNC y del reconocedor CYK genérico.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CYK.cc
+ * @brief Implementación de CNFIndex y CYKRecognizer.
+ */
+
+#include "CYK.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Construye el índice numérico de una gramática en FNC.
+ * @param g Gramática en FNC.
+ * @return índice con reglas unarias y binarias.
+ *
+ * @throws std::runtime_error Si alguna producción no tiene forma A -> a o A -> BC.
+ */
+CNFIndex CNFIndex::FromGrammar(const Grammar& g) {
+    CompactRuleSet rules = CompactRuleSet::FromProductions(g.Productions());
+    return FromRules(g.NonTerminals(), g.StartSymbol(), rules.Names(), {&rules.Rules()});
+}
+
+CNFIndex CNFIndex::FromRules(const std::set<std::string>& nts, const std::string& start,
+                             const std::vector<std::string>& names,
+                             const std::vector<const std::vector<CompactRule>*>& groups) {
+    CNFIndex index;
+
+    // Asignar ids en el orden del conjunto de no terminales
+    for (const auto& nt : nts) {
+        index.ids_[nt] = static_cast<int>(index.names_.size());
+        index.names_.push_back(nt);
+    }
+    index.start_ = index.IdOf(start);
+    if (index.start_ < 0)
+        throw std::runtime_error("El símbolo de arranque no está declarado: '" + start + "'.");
+
+    // Id de símbolo -> id de no terminal (-1 si no es un no terminal declarado)
+    std::vector<int> nt_of(names.size());
+    for (size_t s = 0; s < names.size(); ++s) nt_of[s] = index.IdOf(names[s]);
+
+    // Clasificar cada producción como unaria o binaria
+    for (const auto* group : groups) {
+        for (const CompactRule& r : *group) {
+            if (r.lhs < 0) {
+                throw std::runtime_error("La producción no está en FNC: " + names[~r.lhs] + " -> (" +
+                                         std::to_string(r.rhs[1]) + " símbolos).");
+            }
+            int a = nt_of[r.lhs];
+            if (a < 0) throw std::runtime_error("No terminal no declarado: '" + names[r.lhs] + "'.");
+            if (r.rhs[0] >= 0 && r.rhs[1] < 0 && names[r.rhs[0]].size() == 1 && nt_of[r.rhs[0]] < 0) {
+                index.unary_.push_back(UnaryRule{a, names[r.rhs[0]][0]});
+            } else if (r.rhs[0] >= 0 && r.rhs[1] >= 0 && nt_of[r.rhs[0]] >= 0 && nt_of[r.rhs[1]] >= 0) {
+                index.binary_.push_back(BinaryRule{a, nt_of[r.rhs[0]], nt_of[r.rhs[1]]});
+            } else {
+                std::string rhs = r.rhs[0] < 0 ? "&" : names[r.rhs[0]];
+                if (r.rhs[1] >= 0) rhs += names[r.rhs[1]];
+                throw std::runtime_error("La producción no está en FNC: " + names[r.lhs] + " -> " + rhs + ".");
+            }
+        }
+    }
+    return index;
+}
+
+int CNFIndex::NumNonTerminals() const { return static_cast<int>(names_.size()); }
+
+int CNFIndex::Start() const { return start_; }
+
+const std::string& CNFIndex::Name(int id) const { return names_[id]; }
+
+int CNFIndex::IdOf(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it == ids_.end() ? -1 : it->second;
+}
+
+const std::vector<BinaryRule>& CNFIndex::BinaryRules() const { return binary_; }
+
+const std::vector<UnaryRule>& CNFIndex::UnaryRules() const { return unary_; }
+
+/**
+ * @brief Prepara las tablas del reconocedor: un conjunto de no terminales por byte.
+ * @param index Índice de la gramática en FNC.
+ */
+CYKRecognizer::CYKRecognizer(const CNFIndex& index)
+    : index_(index),
+      words_((static_cast<size_t>(index.NumNonTerminals()) + 63) / 64),
+      unary_by_char_(256, std::vector<uint64_t>(words_, 0)) {
+    for (const auto& r : index_.UnaryRules()) {
+        unary_by_char_[static_cast<unsigned char>(r.terminal)][r.lhs / 64] |= uint64_t(1) << (r.lhs % 64);
+    }
+}
+
+bool CYKTable::Has(size_t i, size_t len, int nt) const {
+    return (Cell(i, len)[nt / 64] >> (nt % 64)) & 1;
+}
+
+size_t CYKTable::Length() const { return n_; }
+
+/**
+ * @brief Algoritmo CYK clásico sobre conjuntos empaquetados en bits.
+ * @param word Cadena de entrada.
+ * @return tabla rellena.
+ */
+CYKTable CYKRecognizer::Fill(const std::string& word) const { return Fill(word, {}); }
+
+/**
+ * @brief Como Fill(word), pero las celdas empiezan con las semillas: las
+ *        combinaciones solo añaden bits, así que basta con ponerlas antes.
+ */
+CYKTable CYKRecognizer::Fill(const std::string& word, const std::vector<CYKSeed>& seeds) const {
+    CYKTable t;
+    const size_t n = word.size();
+    t.n_ = n;
+    t.words_ = words_;
+    t.bits_.assign(n * n * words_, 0);
+
+    // Longitud 1: reglas unarias
+    for (size_t i = 0; i < n; ++i) {
+        const auto& u = unary_by_char_[static_cast<unsigned char>(word[i])];
+        std::copy(u.begin(), u.end(), t.Cell(i, 1));
+    }
+    for (const auto& s : seeds) t.Cell(s.i, s.len)[s.nt / 64] |= uint64_t(1) << (s.nt % 64);
+
+    // Longitudes >= 2: combinar cada corte con todas las reglas binarias
+    for (size_t len = 2; len <= n; ++len) {
+        for (size_t i = 0; i + len <= n; ++i) {
+            uint64_t* out = t.Cell(i, len);
+            for (size_t k = 1; k < len; ++k) {
+                const uint64_t* left = t.Cell(i, k);
+                const uint64_t* right = t.Cell(i + k, len - k);
+                for (const auto& r : index_.BinaryRules()) {
+                    if (((left[r.left / 64] >> (r.left % 64)) & 1) &&
+                        ((right[r.right / 64] >> (r.right % 64)) & 1)) {
+                        out[r.lhs / 64] |= uint64_t(1) << (r.lhs % 64);
+                    }
+                }
+            }
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief Decide la pertenencia rellenando la tabla CYK.
+ * @param word Cadena de entrada.
+ * @return true si el símbolo de arranque genera la cadena.
+ */
+bool CYKRecognizer::Accepts(const std::string& word) const {
+    // Una gramática en FNC (sin producción vacía) no genera la cadena vacía
+    if (word.empty()) return false;
+    return Fill(word).Has(0, word.size(), index_.Start());
+}
+
+const CNFIndex& CYKRecognizer::Index() const { return index_; }
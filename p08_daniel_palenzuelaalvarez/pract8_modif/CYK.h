@@ -0,0 +1,219 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CYK.h: Declaraciones del índice de una gramática en FNC y del
+ *    reconocedor CYK genérico (dirigido por tablas).
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CYK.h
+ * @brief Índice numérico de una gramática en FNC y reconocedor CYK genérico.
+ *
+ * CNFIndex asigna un identificador entero a cada no terminal de una gramática
+ * ya transformada a FNC y separa sus reglas en unarias (A -> a) y binarias
+ * (A -> BC). CYKRecognizer usa ese índice para decidir la pertenencia de una
+ * cadena recorriendo las reglas en tiempo de ejecución.
+ */
+
+#ifndef CYK_H
+#define CYK_H
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "CompactRules.h"
+#include "Grammar2CNF.h"
+
+/**
+ * @brief Regla binaria A -> BC con los no terminales expresados por su id.
+ */
+struct BinaryRule {
+    int lhs;   // A
+    int left;  // B
+    int right; // C
+};
+
+/**
+ * @brief Regla unaria A -> a.
+ */
+struct UnaryRule {
+    int lhs;       // A
+    char terminal; // a
+};
+
+/**
+ * @brief No terminal que se da por reconocido en una subcadena antes de
+ *        combinar celdas (ver CYKRecognizer::Fill()).
+ */
+struct CYKSeed {
+    size_t i;   // posición inicial
+    size_t len; // longitud (>= 1)
+    int nt;     // no terminal
+};
+
+/**
+ * @class CNFIndex
+ * @brief Representación numérica de una gramática en FNC.
+ *
+ * Los identificadores de los no terminales siguen el orden del conjunto de no
+ * terminales de la gramática, de modo que el índice es determinista.
+ */
+class CNFIndex {
+public:
+    /**
+     * @brief Construye el índice a partir de una gramática en FNC.
+     * @param g Gramática ya transformada con TransformToCNF().
+     * @throws std::runtime_error Si alguna producción no está en FNC.
+     */
+    static CNFIndex FromGrammar(const Grammar& g);
+
+    /**
+     * @brief Construye el índice a partir de producciones compactas repartidas
+     *        en grupos.
+     * @param nonterminals No terminales declarados (fijan los ids).
+     * @param start Símbolo de arranque.
+     * @param names Nombres de los símbolos de las reglas: id -> símbolo.
+     * @param groups Grupos de producciones en FNC, en orden.
+     * @throws std::runtime_error Si el arranque no está declarado o alguna
+     *         producción no está en FNC.
+     */
+    static CNFIndex FromRules(const std::set<std::string>& nonterminals, const std::string& start,
+                              const std::vector<std::string>& names,
+                              const std::vector<const std::vector<CompactRule>*>& groups);
+
+    /**
+     * @brief Número de no terminales del índice.
+     */
+    int NumNonTerminals() const;
+
+    /**
+     * @brief Identificador del símbolo de arranque.
+     */
+    int Start() const;
+
+    /**
+     * @brief Nombre del no terminal con identificador id.
+     */
+    const std::string& Name(int id) const;
+
+    /**
+     * @brief Identificador del no terminal name, o -1 si no existe.
+     */
+    int IdOf(const std::string& name) const;
+
+    /**
+     * @brief Reglas binarias A -> BC.
+     */
+    const std::vector<BinaryRule>& BinaryRules() const;
+
+    /**
+     * @brief Reglas unarias A -> a.
+     */
+    const std::vector<UnaryRule>& UnaryRules() const;
+
+private:
+    std::vector<std::string> names_;   // id -> nombre
+    std::map<std::string, int> ids_;   // nombre -> id
+    int start_ = -1;                   // id del símbolo de arranque
+    std::vector<BinaryRule> binary_;   // reglas A -> BC
+    std::vector<UnaryRule> unary_;     // reglas A -> a
+};
+
+/**
+ * @class CYKTable
+ * @brief Tabla CYK ya rellena para una cadena concreta.
+ *
+ * La celda (i, len) contiene los no terminales que generan la subcadena que
+ * empieza en la posición i y tiene longitud len.
+ */
+class CYKTable {
+public:
+    /**
+     * @brief Indica si el no terminal nt genera la subcadena (i, len).
+     */
+    bool Has(size_t i, size_t len, int nt) const;
+
+    /**
+     * @brief Longitud de la cadena analizada.
+     */
+    size_t Length() const;
+
+private:
+    friend class CYKRecognizer;
+    size_t n_ = 0;               // longitud de la cadena
+    size_t words_ = 0;           // palabras de 64 bits por celda
+    std::vector<uint64_t> bits_; // celdas consecutivas, por longitud y posición
+
+    uint64_t* Cell(size_t i, size_t len) { return &bits_[((len - 1) * n_ + i) * words_]; }
+    const uint64_t* Cell(size_t i, size_t len) const { return &bits_[((len - 1) * n_ + i) * words_]; }
+};
+
+/**
+ * @class CYKRecognizer
+ * @brief Reconocedor CYK genérico dirigido por tablas.
+ *
+ * Cada celda de la tabla es un conjunto de no terminales empaquetado en
+ * palabras de 64 bits; el paso de combinación recorre la lista de reglas
+ * binarias para cada punto de corte.
+ */
+class CYKRecognizer {
+public:
+    /**
+     * @brief Prepara el reconocedor para el índice dado.
+     * @param index Índice de la gramática en FNC (se copia).
+     */
+    explicit CYKRecognizer(const CNFIndex& index);
+
+    /**
+     * @brief Decide si la cadena pertenece al lenguaje de la gramática.
+     * @param word Cadena de entrada.
+     * @return true si la cadena es generada desde el símbolo de arranque.
+     */
+    bool Accepts(const std::string& word) const;
+
+    /**
+     * @brief Rellena la tabla CYK completa para la cadena.
+     * @param word Cadena de entrada.
+     * @return tabla con los no terminales de cada subcadena.
+     */
+    CYKTable Fill(const std::string& word) const;
+
+    /**
+     * @brief Rellena la tabla CYK añadiendo antes los no terminales dados.
+     *
+     * Permite usar hojas que no tienen reglas en el índice y cuyo lenguaje
+     * se reconoce por otro medio (por ejemplo, un AFD) en subcadenas de
+     * cualquier longitud.
+     *
+     * @param word Cadena de entrada.
+     * @param seeds Celdas iniciales adicionales.
+     * @return tabla con los no terminales de cada subcadena.
+     */
+    CYKTable Fill(const std::string& word, const std::vector<CYKSeed>& seeds) const;
+
+    /**
+     * @brief Índice de la gramática usado por el reconocedor.
+     */
+    const CNFIndex& Index() const;
+
+private:
+    CNFIndex index_;
+    size_t words_; // palabras de 64 bits por conjunto de no terminales
+    std::vector<std::vector<uint64_t>> unary_by_char_; // byte -> {A | A -> byte}
+};
+
+#endif
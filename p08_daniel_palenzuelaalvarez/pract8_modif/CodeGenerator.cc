@@ -0,0 +1,176 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CodeGenerator.cc: Implementación del generador de reconocedores C++.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CodeGenerator.cc
+ * @brief Implementación de EmitCppRecognizer.
+ */
+
+#include "CodeGenerator.h"
+
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Texto de un nombre para los comentarios // del código generado.
+ *
+ * Cada '\' se escribe como "\x5c": una barra al final de la línea la uniría
+ * con la siguiente (empalme de líneas) y el comentario se tragaría código.
+ */
+static std::string CommentText(const std::string& name) {
+    std::string out;
+    for (char c : name) {
+        if (c == '\\') out += "\\x5c";
+        else out += c;
+    }
+    return out;
+}
+
+/**
+ * @brief Genera el reconocedor especializado.
+ * @param index Índice de la gramática en FNC.
+ * @param path Ruta del fichero de salida.
+ *
+ * @throws std::runtime_error Si no se puede crear el fichero.
+ */
+void EmitCppRecognizer(const CNFIndex& index, const std::string& path) {
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("No se pudo crear el fichero de salida: " + path);
+    }
+
+    const int n = index.NumNonTerminals();
+
+    // Agrupar reglas unarias por terminal: byte -> {A}
+    std::map<unsigned char, std::set<int>> unary;
+    for (const auto& r : index.UnaryRules()) unary[static_cast<unsigned char>(r.terminal)].insert(r.lhs);
+
+    // Agrupar reglas binarias por B y, dentro de cada B, por A: B -> A -> {C}
+    std::map<int, std::map<int, std::set<int>>> binary;
+    for (const auto& r : index.BinaryRules()) binary[r.left][r.lhs].insert(r.right);
+
+    // Cabecera del fichero generado
+    ofs << "// Reconocedor CYK especializado generado por Grammar2CNF --emit-cpp.\n"
+        << "// Compilar con: g++ -std=c++17 -O2 <fichero>.cc -o reconocedor\n"
+        << "//\n"
+        << "// No terminales:\n";
+    for (int id = 0; id < n; ++id) ofs << "//   " << id << ": " << CommentText(index.Name(id)) << "\n";
+    ofs << "\n"
+        << "#include <bitset>\n"
+        << "#include <chrono>\n"
+        << "#include <cstdlib>\n"
+        << "#include <iostream>\n"
+        << "#include <string>\n"
+        << "#include <vector>\n"
+        << "\n"
+        << "namespace {\n"
+        << "\n"
+        << "constexpr std::size_t kNumNonTerminals = " << n << ";\n"
+        << "constexpr std::size_t kStart = " << index.Start() << "; // " << CommentText(index.Name(index.Start())) << "\n"
+        << "using Set = std::bitset<kNumNonTerminals>;\n"
+        << "\n";
+
+    // Reglas unarias: un switch por byte
+    ofs << "// Conjunto {A | A -> c}\n"
+        << "inline Set Unary(unsigned char c) {\n"
+        << "    Set s;\n"
+        << "    switch (c) {\n";
+    for (const auto& [c, lhs] : unary) {
+        ofs << "    case " << static_cast<int>(c) << ":";
+        if (std::isalnum(c)) ofs << " // '" << static_cast<char>(c) << "'";
+        ofs << "\n       ";
+        for (int a : lhs) ofs << " s.set(" << a << ");";
+        ofs << "\n        break;\n";
+    }
+    ofs << "    default:\n"
+        << "        break;\n"
+        << "    }\n"
+        << "    return s;\n"
+        << "}\n"
+        << "\n";
+
+    // Paso de combinación desenrollado: out |= {A | A -> BC, B en l, C en r}
+    ofs << "// out |= {A | A -> BC, B en l, C en r}, desenrollado por B\n"
+        << "inline void Combine(const Set& l, const Set& r, Set& out) {\n";
+    for (const auto& [b, by_lhs] : binary) {
+        ofs << "    if (l[" << b << "]) { // " << CommentText(index.Name(b)) << "\n";
+        for (const auto& [a, rights] : by_lhs) {
+            ofs << "        if (";
+            bool first = true;
+            for (int c : rights) {
+                if (!first) ofs << " || ";
+                ofs << "r[" << c << "]";
+                first = false;
+            }
+            ofs << ") out.set(" << a << "); // " << CommentText(index.Name(a)) << " -> " << CommentText(index.Name(b)) << " {";
+            first = true;
+            for (int c : rights) {
+                if (!first) ofs << ", ";
+                ofs << CommentText(index.Name(c));
+                first = false;
+            }
+            ofs << "}\n";
+        }
+        ofs << "    }\n";
+    }
+    ofs << "}\n"
+        << "\n";
+
+    // Bucle CYK y programa principal (comunes a todas las gramáticas)
+    ofs << "bool Accepts(const std::string& w) {\n"
+        << "    const std::size_t n = w.size();\n"
+        << "    if (n == 0) return false;\n"
+        << "    std::vector<Set> t(n * n);\n"
+        << "    auto cell = [&](std::size_t i, std::size_t len) -> Set& { return t[(len - 1) * n + i]; };\n"
+        << "    for (std::size_t i = 0; i < n; ++i) cell(i, 1) = Unary(static_cast<unsigned char>(w[i]));\n"
+        << "    for (std::size_t len = 2; len <= n; ++len) {\n"
+        << "        for (std::size_t i = 0; i + len <= n; ++i) {\n"
+        << "            Set& out = cell(i, len);\n"
+        << "            for (std::size_t k = 1; k < len; ++k) Combine(cell(i, k), cell(i + k, len - k), out);\n"
+        << "        }\n"
+        << "    }\n"
+        << "    return cell(0, n)[kStart];\n"
+        << "}\n"
+        << "\n"
+        << "} // namespace\n"
+        << "\n"
+        << "int main(int argc, char* argv[]) {\n"
+        << "    if (argc < 2 || argc > 3) {\n"
+        << "        std::cerr << \"Modo de empleo: \" << argv[0] << \" cadena [repeticiones]\\n\";\n"
+        << "        return 1;\n"
+        << "    }\n"
+        << "    std::string word = argv[1];\n"
+        << "    long reps = argc == 3 ? std::atol(argv[2]) : 1;\n"
+        << "    if (reps < 1) reps = 1;\n"
+        << "    bool accepted = false;\n"
+        << "    auto t0 = std::chrono::steady_clock::now();\n"
+        << "    for (long r = 0; r < reps; ++r) accepted = Accepts(word);\n"
+        << "    auto t1 = std::chrono::steady_clock::now();\n"
+        << "    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;\n"
+        << "    std::cout << \"Resultado: \" << (accepted ? \"aceptada\" : \"rechazada\") << \"\\n\";\n"
+        << "    std::cout << \"Tiempo medio: \" << us << \" us (\" << reps << \" repeticiones)\\n\";\n"
+        << "    return accepted ? 0 : 3;\n"
+        << "}\n";
+
+    if (!ofs) {
+        throw std::runtime_error("Error al escribir el fichero de salida: " + path);
+    }
+}
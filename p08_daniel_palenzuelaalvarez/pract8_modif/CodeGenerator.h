@@ -0,0 +1,49 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CodeGenerator.h: Generador de reconocedores C++ especializados
+ *    para una gramática en FNC.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CodeGenerator.h
+ * @brief Generación de un reconocedor CYK especializado en C++.
+ *
+ * El fichero generado es autónomo (solo usa la biblioteca estándar): los
+ * conjuntos de no terminales son std::bitset del tamaño exacto de la
+ * gramática y el paso de combinación de CYK está desenrollado en
+ * operaciones de bits, agrupadas por el no terminal izquierdo B.
+ */
+
+#ifndef CODE_GENERATOR_H
+#define CODE_GENERATOR_H
+
+#include <string>
+
+#include "CYK.h"
+
+/**
+ * @brief Escribe en path un programa C++ que reconoce el lenguaje de la gramática.
+ *
+ * El programa generado se usa como: ./reconocedor cadena [repeticiones]
+ * e informa de si la cadena se acepta y del tiempo medio por repetición,
+ * con el mismo formato que el modo --bench de Grammar2CNF.
+ *
+ * @param index Índice de la gramática en FNC.
+ * @param path Ruta del fichero .cc a generar.
+ * @throws std::runtime_error Si no se puede crear el fichero.
+ */
+void EmitCppRecognizer(const CNFIndex& index, const std::string& path);
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CompactRules.cc: Implementación de la representación compacta de producciones.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CompactRules.cc
+ * @brief Implementación de CompactRuleSet.
+ */
+
+#include "CompactRules.h"
+
+#include <unordered_map>
+
+/**
+ * @brief Bytes de memoria dinámica de una cadena (0 si cabe en el búfer interno).
+ */
+static size_t StringHeapBytes(const std::string& s) {
+    static const size_t kInline = std::string().capacity();
+    return s.capacity() > kInline ? s.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Reglas con RHS de hasta dos símbolos en línea; las demás, en la tabla auxiliar.
+ */
+CompactRuleSet CompactRuleSet::FromProductions(const std::vector<Production>& productions) {
+    CompactRuleSet set;
+    // La tabla nombre -> id solo hace falta durante la construcción
+    std::unordered_map<std::string, int32_t> ids;
+    auto intern = [&](const std::string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        int32_t id = static_cast<int32_t>(set.names_.size());
+        ids.emplace(name, id);
+        set.names_.push_back(name);
+        return id;
+    };
+
+    set.rules_.reserve(productions.size());
+    for (const auto& p : productions) {
+        CompactRule r{intern(p.lhs), {-1, -1}};
+        bool empty = p.IsEmpty();
+        if (empty) {
+            // producción vacía: sin símbolos
+        } else if (p.rhs.size() <= 2) {
+            for (size_t k = 0; k < p.rhs.size(); ++k) r.rhs[k] = intern(p.rhs[k]);
+        } else {
+            r.rhs[0] = static_cast<int32_t>(set.long_rhs_.size());
+            r.rhs[1] = static_cast<int32_t>(p.rhs.size());
+            for (const auto& tok : p.rhs) set.long_rhs_.push_back(intern(tok));
+            r.lhs = ~r.lhs;
+        }
+        set.rules_.push_back(r);
+    }
+    set.names_.shrink_to_fit();
+    set.long_rhs_.shrink_to_fit();
+    return set;
+}
+
+size_t CompactRuleSet::Size() const { return rules_.size(); }
+
+int32_t CompactRuleSet::Lhs(size_t i) const {
+    return rules_[i].lhs < 0 ? ~rules_[i].lhs : rules_[i].lhs;
+}
+
+size_t CompactRuleSet::RhsSize(size_t i) const {
+    const CompactRule& r = rules_[i];
+    if (r.lhs < 0) return static_cast<size_t>(r.rhs[1]);
+    return r.rhs[0] < 0 ? 0 : (r.rhs[1] < 0 ? 1 : 2);
+}
+
+int32_t CompactRuleSet::Rhs(size_t i, size_t k) const {
+    const CompactRule& r = rules_[i];
+    return r.lhs < 0 ? long_rhs_[static_cast<size_t>(r.rhs[0]) + k] : r.rhs[k];
+}
+
+const std::string& CompactRuleSet::Name(int32_t id) const { return names_[static_cast<size_t>(id)]; }
+
+Production CompactRuleSet::ToProduction(size_t i) const {
+    Production p;
+    p.lhs = Name(Lhs(i));
+    size_t m = RhsSize(i);
+    if (m == 0) p.rhs.push_back("&");
+    for (size_t k = 0; k < m; ++k) p.rhs.push_back(Name(Rhs(i, k)));
+    if (m == 1 && p.rhs[0] == "&") p.quoted.assign(1, true); // terminal '&'
+    return p;
+}
+
+size_t CompactRuleSet::RuleBytes() const {
+    return rules_.capacity() * sizeof(CompactRule) + long_rhs_.capacity() * sizeof(int32_t);
+}
+
+size_t CompactRuleSet::NameBytes() const {
+    size_t bytes = names_.capacity() * sizeof(std::string);
+    for (const auto& n : names_) bytes += StringHeapBytes(n);
+    return bytes;
+}
+
+size_t CompactRuleSet::ProductionBytes(const std::vector<Production>& productions) {
+    size_t bytes = productions.capacity() * sizeof(Production);
+    for (const auto& p : productions) {
+        bytes += StringHeapBytes(p.lhs);
+        bytes += p.rhs.capacity() * sizeof(std::string);
+        for (const auto& tok : p.rhs) bytes += StringHeapBytes(tok);
+    }
+    return bytes;
+}
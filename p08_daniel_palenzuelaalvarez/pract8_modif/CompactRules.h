@@ -0,0 +1,129 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CompactRules.h: Representación compacta de producciones con ids
+ *    de símbolo y almacenamiento en línea para RHS de hasta dos símbolos.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CompactRules.h
+ * @brief Producciones de 12 bytes: LHS y hasta dos símbolos de la RHS como ids.
+ *
+ * Una producción en FNC (A -> a o A -> BC) cabe entera en un CompactRule. Las
+ * RHS más largas (las de la gramática original) se guardan en una tabla
+ * auxiliar compartida y el CompactRule solo indica dónde empiezan y cuántos
+ * símbolos tienen. Los nombres de los símbolos se guardan una sola vez; la
+ * tabla nombre -> id solo se usa al construir.
+ */
+
+#ifndef COMPACT_RULES_H
+#define COMPACT_RULES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Grammar2CNF.h"
+
+/**
+ * @brief Producción compacta.
+ *
+ * Si lhs >= 0, rhs contiene los ids de la RHS (rhs[1] == -1 si tiene un solo
+ * símbolo, y ambos -1 para la producción vacía). Si lhs < 0, la LHS es ~lhs y
+ * la RHS son rhs[1] símbolos de la tabla auxiliar a partir de rhs[0].
+ */
+struct CompactRule {
+    int32_t lhs;    // id de la LHS (complementado si la RHS está en la tabla auxiliar)
+    int32_t rhs[2]; // ids de la RHS, o (inicio, longitud) en la tabla auxiliar
+};
+
+static_assert(sizeof(CompactRule) == 12, "CompactRule debe ocupar 12 bytes");
+
+/**
+ * @class CompactRuleSet
+ * @brief Conjunto de producciones compactas con su tabla de nombres.
+ */
+class CompactRuleSet {
+public:
+    /**
+     * @brief Construye la representación compacta de un vector de producciones.
+     * @param productions Producciones en el formato de Grammar.
+     */
+    static CompactRuleSet FromProductions(const std::vector<Production>& productions);
+
+    /**
+     * @brief Número de producciones.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Id de la LHS de la producción i.
+     */
+    int32_t Lhs(size_t i) const;
+
+    /**
+     * @brief Número de símbolos de la RHS de la producción i (0 si es vacía).
+     */
+    size_t RhsSize(size_t i) const;
+
+    /**
+     * @brief Id del símbolo k de la RHS de la producción i.
+     */
+    int32_t Rhs(size_t i, size_t k) const;
+
+    /**
+     * @brief Nombre del símbolo con el id dado.
+     */
+    const std::string& Name(int32_t id) const;
+
+    /**
+     * @brief Producciones compactas, en el orden de construcción.
+     */
+    const std::vector<CompactRule>& Rules() const { return rules_; }
+
+    /**
+     * @brief Tabla de nombres: id -> símbolo.
+     */
+    const std::vector<std::string>& Names() const { return names_; }
+
+    /**
+     * @brief Reconstruye la producción i en el formato de Grammar.
+     */
+    Production ToProduction(size_t i) const;
+
+    /**
+     * @brief Bytes ocupados por las reglas y la tabla auxiliar (sin la tabla de nombres).
+     */
+    size_t RuleBytes() const;
+
+    /**
+     * @brief Bytes ocupados por la tabla de nombres.
+     */
+    size_t NameBytes() const;
+
+    /**
+     * @brief Bytes que ocupa un vector de producciones de Grammar: la propia
+     *        struct, la capacidad de los vectores y las cadenas que no caben
+     *        en el búfer interno de std::string (sin la cabecera de malloc).
+     */
+    static size_t ProductionBytes(const std::vector<Production>& productions);
+
+private:
+    std::vector<CompactRule> rules_;     // producciones
+    std::vector<int32_t> long_rhs_;      // RHS de más de dos símbolos
+    std::vector<std::string> names_;     // id -> nombre
+};
+
+#endif
@@ -0,0 +1,275 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CompiledGrammar.cc: Implementación de CompiledGrammar y GrammarPublisher.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CompiledGrammar.cc
+ * @brief Implementación de las instantáneas y de su publicación.
+ */
+
+#include "CompiledGrammar.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Id del símbolo en la tabla, añadiéndolo al final si no estaba.
+ */
+int32_t Intern(CompiledGrammar::Symbols& table, const std::string& name) {
+    auto it = table.ids.find(name);
+    if (it != table.ids.end()) return it->second;
+    int32_t id = static_cast<int32_t>(table.names.size());
+    table.ids.emplace(name, id);
+    table.names.push_back(name);
+    return id;
+}
+
+/**
+ * @brief Comprueba que la RHS cabe en una CompactRule sin tabla auxiliar.
+ * @throws std::runtime_error Si tiene más de dos símbolos (no está en FNC).
+ */
+void CheckLength(const Production& p) {
+    if (p.rhs.size() <= 2) return;
+    std::string rhs;
+    for (const auto& tok : p.rhs) rhs += tok;
+    throw std::runtime_error("La producción no está en FNC: " + p.lhs + " -> " + rhs + ".");
+}
+
+/**
+ * @brief Forma compacta de p; todos sus símbolos deben estar ya en la tabla.
+ */
+CompactRule Encode(const Production& p, const CompiledGrammar::Symbols& table) {
+    CompactRule r{table.ids.at(p.lhs), {-1, -1}};
+    bool empty = p.IsEmpty();
+    if (!empty) {
+        for (size_t k = 0; k < p.rhs.size(); ++k) r.rhs[k] = table.ids.at(p.rhs[k]);
+    }
+    return r;
+}
+
+/**
+ * @brief Añade a la tabla los símbolos de p (salvo el de la cadena vacía).
+ */
+void InternAll(CompiledGrammar::Symbols& table, const Production& p) {
+    Intern(table, p.lhs);
+    if (p.IsEmpty()) return;
+    for (const auto& tok : p.rhs) Intern(table, tok);
+}
+
+/**
+ * @brief Indica si InternAll() no añadiría nada a la tabla.
+ */
+bool AllInterned(const CompiledGrammar::Symbols& table, const Production& p) {
+    auto known = [&](const std::string& name) { return table.ids.count(name) != 0; };
+    if (!known(p.lhs)) return false;
+    if (p.IsEmpty()) return true;
+    return std::all_of(p.rhs.begin(), p.rhs.end(), known);
+}
+
+} // namespace
+
+/**
+ * @brief Agrupa las producciones por LHS conservando su orden relativo.
+ */
+std::shared_ptr<const CompiledGrammar> CompiledGrammar::FromGrammar(const Grammar& g) {
+    std::shared_ptr<CompiledGrammar> snapshot(new CompiledGrammar());
+    snapshot->start_ = g.StartSymbol();
+    snapshot->nonterminals_ = g.NonTerminals();
+    snapshot->terminals_ = g.Terminals();
+    auto table = std::make_shared<Symbols>();
+    for (const auto& p : g.Productions()) {
+        CheckLength(p);
+        InternAll(*table, p);
+    }
+    std::map<std::string, Rules> groups;
+    for (const auto& p : g.Productions()) groups[p.lhs].push_back(Encode(p, *table));
+    for (auto& [lhs, rules] : groups) {
+        snapshot->groups_.emplace(lhs, std::make_shared<const Rules>(std::move(rules)));
+    }
+    snapshot->symbols_ = std::move(table);
+    snapshot->Finish();
+    return snapshot;
+}
+
+std::shared_ptr<const CompiledGrammar::Rules> CompiledGrammar::RulesOf(const std::string& lhs) const {
+    auto it = groups_.find(lhs);
+    return it == groups_.end() ? nullptr : it->second;
+}
+
+Production CompiledGrammar::ToProduction(const CompactRule& r) const {
+    Production p;
+    p.lhs = SymbolName(r.lhs);
+    if (r.rhs[0] < 0) p.rhs.push_back("&");
+    for (int32_t id : r.rhs) {
+        if (id >= 0) p.rhs.push_back(SymbolName(id));
+    }
+    if (r.rhs[0] >= 0 && r.rhs[1] < 0 && p.rhs[0] == "&") p.quoted.assign(1, true); // terminal '&'
+    return p;
+}
+
+/**
+ * @brief El índice CNF se reconstruye entero: los ids de no terminal y las
+ *        tablas por byte del reconocedor dependen de toda la gramática.
+ */
+void CompiledGrammar::Finish() {
+    std::vector<const Rules*> groups;
+    num_productions_ = 0;
+    for (const auto& [lhs, rules] : groups_) {
+        groups.push_back(rules.get());
+        num_productions_ += rules->size();
+    }
+    cyk_ = std::make_shared<const CYKRecognizer>(
+        CNFIndex::FromRules(nonterminals_, start_, symbols_->names, groups));
+}
+
+namespace {
+
+std::atomic<uint64_t> next_publisher_id(1);
+
+/**
+ * @brief Entrada de la caché de instantáneas de un hilo.
+ */
+struct CachedSnapshot {
+    uint64_t publisher = 0; // id del publicador (0: vacía)
+    uint64_t published = 0; // valor del contador cuando se leyó la instantánea
+    std::shared_ptr<const CompiledGrammar> snapshot;
+};
+
+} // namespace
+
+GrammarPublisher::GrammarPublisher(std::shared_ptr<const CompiledGrammar> initial)
+    : id_(next_publisher_id.fetch_add(1, std::memory_order_relaxed)), current_(std::move(initial)) {
+    if (!current_) throw std::runtime_error("GrammarPublisher: instantánea inicial nula.");
+}
+
+/**
+ * @brief Si el contador no ha cambiado, la instantánea de la caché es la
+ *        vigente; si no, se recarga current_.
+ *
+ * La carga con acquire del contador sincroniza con el incremento que hizo el
+ * escritor después de guardar current_, así que la instantánea que se recarga
+ * es como mínimo la de esa publicación. Si entretanto se publica otra, se
+ * guarda con el valor antiguo del contador y se recarga en la lectura
+ * siguiente.
+ */
+std::shared_ptr<const CompiledGrammar> GrammarPublisher::Snapshot() const {
+    thread_local std::array<CachedSnapshot, kCacheSlots> cache;
+    CachedSnapshot& slot = cache[id_ % kCacheSlots];
+    uint64_t published = published_.load(std::memory_order_acquire);
+    if (slot.publisher != id_ || slot.published != published) {
+        slot.snapshot = std::atomic_load(&current_);
+        slot.publisher = id_;
+        slot.published = published;
+    }
+    return slot.snapshot;
+}
+
+std::shared_ptr<const CompiledGrammar> GrammarPublisher::ReplaceRules(const std::string& lhs,
+                                                                     std::vector<Production> rules) {
+    std::lock_guard<std::mutex> lock(writers_);
+    return Publish(lhs, std::move(rules));
+}
+
+std::shared_ptr<const CompiledGrammar> GrammarPublisher::AddRule(const Production& rule) {
+    std::lock_guard<std::mutex> lock(writers_);
+    std::vector<Production> rules = CurrentRules(rule.lhs);
+    auto same = [&](const Production& p) { return p.rhs == rule.rhs; };
+    if (std::find_if(rules.begin(), rules.end(), same) != rules.end()) return current_;
+    rules.push_back(rule);
+    return Publish(rule.lhs, std::move(rules));
+}
+
+std::shared_ptr<const CompiledGrammar> GrammarPublisher::RemoveRule(const Production& rule) {
+    std::lock_guard<std::mutex> lock(writers_);
+    std::vector<Production> rules = CurrentRules(rule.lhs);
+    auto same = [&](const Production& p) { return p.rhs == rule.rhs; };
+    auto it = std::remove_if(rules.begin(), rules.end(), same);
+    if (it == rules.end()) return current_;
+    rules.erase(it, rules.end());
+    return Publish(rule.lhs, std::move(rules));
+}
+
+std::vector<Production> GrammarPublisher::CurrentRules(const std::string& lhs) const {
+    std::vector<Production> rules;
+    if (auto group = current_->RulesOf(lhs)) {
+        for (const CompactRule& r : *group) rules.push_back(current_->ToProduction(r));
+    }
+    return rules;
+}
+
+/**
+ * @brief Construye la versión siguiente compartiendo los grupos no
+ *        modificados y la publica.
+ *
+ * La tabla de símbolos solo se copia si alguna regla trae un símbolo nuevo.
+ * Solo los escritores, que tienen el cerrojo, modifican current_, así que
+ * aquí se puede leer sin carga atómica; la escritura sí es atómica porque
+ * los lectores pueden estar cargándolo.
+ */
+std::shared_ptr<const CompiledGrammar> GrammarPublisher::Publish(const std::string& lhs,
+                                                                 std::vector<Production> rules) {
+    const CompiledGrammar& old = *current_;
+    for (const auto& p : rules) {
+        if (p.lhs != lhs) throw std::runtime_error("La producción no es de " + lhs + ": " + p.lhs + ".");
+        CheckLength(p);
+        if (p.rhs.size() == 1) {
+            const std::string& tok = p.rhs[0];
+            if (tok.size() != 1 || old.terminals_.count(tok[0]) == 0)
+                throw std::runtime_error("Terminal en RHS no declarado: '" + tok + "'.");
+            continue;
+        }
+        for (const auto& tok : p.rhs) {
+            if (tok != lhs && old.nonterminals_.count(tok) == 0)
+                throw std::runtime_error("No terminal no declarado: '" + tok + "'.");
+        }
+    }
+
+    std::shared_ptr<const CompiledGrammar::Symbols> table = old.symbols_;
+    for (const auto& p : rules) {
+        if (AllInterned(*table, p)) continue;
+        auto grown = std::make_shared<CompiledGrammar::Symbols>(*table);
+        for (const auto& q : rules) InternAll(*grown, q);
+        table = std::move(grown);
+        break;
+    }
+    CompiledGrammar::Rules group;
+    group.reserve(rules.size());
+    for (const auto& p : rules) group.push_back(Encode(p, *table));
+
+    std::shared_ptr<CompiledGrammar> next(new CompiledGrammar());
+    next->start_ = old.start_;
+    next->nonterminals_ = old.nonterminals_;
+    next->nonterminals_.insert(lhs);
+    next->terminals_ = old.terminals_;
+    next->symbols_ = std::move(table);
+    next->groups_ = old.groups_;
+    if (group.empty()) {
+        next->groups_.erase(lhs);
+    } else {
+        next->groups_[lhs] = std::make_shared<const CompiledGrammar::Rules>(std::move(group));
+    }
+    next->version_ = old.version_ + 1;
+    next->Finish(); // lanza si alguna regla no está en FNC
+
+    std::shared_ptr<const CompiledGrammar> published = std::move(next);
+    std::atomic_store(&current_, published);
+    published_.fetch_add(1, std::memory_order_release);
+    return published;
+}
@@ -0,0 +1,223 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: CompiledGrammar.h: Instantáneas inmutables de una gramática en FNC.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file CompiledGrammar.h
+ * @brief Gramática en FNC de solo lectura, compartible entre hilos sin cerrojos,
+ *        y publicador de versiones nuevas.
+ *
+ * Las producciones se guardan agrupadas por LHS, cada grupo en un vector
+ * inmutable compartido de CompactRule (12 bytes por regla) cuyos ids se
+ * resuelven con una tabla de símbolos también compartida. Una edición crea
+ * una instantánea nueva que comparte todos los grupos salvo el modificado
+ * (copia en escritura) y la publica sustituyendo el puntero de forma atómica;
+ * quien ya tenía la anterior la sigue usando hasta soltarla.
+ */
+
+#ifndef COMPILED_GRAMMAR_H
+#define COMPILED_GRAMMAR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CYK.h"
+#include "CompactRules.h"
+
+/**
+ * @class CompiledGrammar
+ * @brief Instantánea inmutable de una gramática en FNC con su reconocedor CYK.
+ *
+ * Todos los métodos son const y no modifican nada, así que una misma
+ * instantánea se puede consultar desde varios hilos a la vez.
+ */
+class CompiledGrammar {
+public:
+    using Rules = std::vector<CompactRule>;
+    using Groups = std::map<std::string, std::shared_ptr<const Rules>>;
+
+    /**
+     * @brief Tabla de símbolos de las reglas. Entre versiones solo crece, así
+     *        que los ids de un grupo no modificado siguen siendo válidos.
+     */
+    struct Symbols {
+        std::vector<std::string> names;               // id -> símbolo
+        std::unordered_map<std::string, int32_t> ids; // símbolo -> id
+    };
+
+    /**
+     * @brief Crea la instantánea de una gramática ya convertida.
+     * @param g Gramática transformada con TransformToCNF().
+     * @throws std::runtime_error Si alguna producción no está en FNC.
+     */
+    static std::shared_ptr<const CompiledGrammar> FromGrammar(const Grammar& g);
+
+    /**
+     * @brief Símbolo de arranque.
+     */
+    const std::string& StartSymbol() const { return start_; }
+
+    /**
+     * @brief No terminales declarados (también los que no tienen reglas).
+     */
+    const std::set<std::string>& NonTerminals() const { return nonterminals_; }
+
+    /**
+     * @brief Terminales declarados en la gramática de partida.
+     */
+    const std::set<char>& Terminals() const { return terminals_; }
+
+    /**
+     * @brief Producciones agrupadas por LHS.
+     */
+    const Groups& RuleGroups() const { return groups_; }
+
+    /**
+     * @brief Producciones del no terminal lhs, o nullptr si no tiene.
+     */
+    std::shared_ptr<const Rules> RulesOf(const std::string& lhs) const;
+
+    /**
+     * @brief Nombre del símbolo con el id dado.
+     */
+    const std::string& SymbolName(int32_t id) const { return symbols_->names[static_cast<size_t>(id)]; }
+
+    /**
+     * @brief Producción equivalente a una regla compacta de esta instantánea.
+     */
+    Production ToProduction(const CompactRule& r) const;
+
+    /**
+     * @brief Número total de producciones.
+     */
+    size_t NumProductions() const { return num_productions_; }
+
+    /**
+     * @brief Número de versión: 0 para la instantánea inicial y uno más por
+     *        cada edición publicada a partir de ella.
+     */
+    uint64_t Version() const { return version_; }
+
+    /**
+     * @brief Decide con CYK si la cadena pertenece al lenguaje.
+     */
+    bool Accepts(const std::string& word) const { return cyk_->Accepts(word); }
+
+private:
+    friend class GrammarPublisher;
+
+    CompiledGrammar() = default;
+
+    /**
+     * @brief Completa la instantánea a partir de sus grupos: cuenta las
+     *        producciones y construye el reconocedor.
+     */
+    void Finish();
+
+    std::string start_;
+    std::set<std::string> nonterminals_;
+    std::set<char> terminals_;
+    std::shared_ptr<const Symbols> symbols_;
+    Groups groups_;
+    size_t num_productions_ = 0;
+    uint64_t version_ = 0;
+    std::shared_ptr<const CYKRecognizer> cyk_;
+};
+
+/**
+ * @class GrammarPublisher
+ * @brief Punto de publicación de las versiones de una gramática compilada.
+ *
+ * Las ediciones se serializan entre sí con un mutex propio de los escritores;
+ * cada una guarda la instantánea nueva con std::atomic_store y después
+ * incrementa un contador de publicaciones. Los lectores obtienen la versión
+ * vigente con Snapshot(), que consulta el contador y, si no ha cambiado desde
+ * la última lectura del hilo, devuelve la instantánea guardada en una caché
+ * local al hilo sin tomar ningún cerrojo. Solo la primera lectura de cada hilo
+ * tras una publicación pasa por std::atomic_load, que en libstdc++ protege el
+ * puntero compartido con un cerrojo interno.
+ */
+class GrammarPublisher {
+public:
+    /**
+     * @brief Empieza publicando la instantánea dada.
+     */
+    explicit GrammarPublisher(std::shared_ptr<const CompiledGrammar> initial);
+
+    /**
+     * @brief Instantánea vigente (o una posterior, si se publica a la vez).
+     *
+     * La caché de cada hilo tiene kCacheSlots entradas, elegidas por el
+     * identificador del publicador, y cada entrada mantiene viva la última
+     * instantánea que leyó ese hilo hasta que la sustituye otra lectura.
+     */
+    std::shared_ptr<const CompiledGrammar> Snapshot() const;
+
+    /**
+     * @brief Sustituye todas las producciones de lhs y publica el resultado.
+     *
+     * Solo se copia el mapa de grupos (punteros) y el grupo de lhs; el resto
+     * se comparte con la versión anterior. Si lhs no estaba declarado, se
+     * declara; si rules es vacío, lhs queda sin reglas.
+     *
+     * @param lhs No terminal cuyas reglas se sustituyen.
+     * @param rules Nuevas producciones de lhs en FNC (A -> a con a terminal
+     *        declarado, o A -> B C con B y C ya declarados o iguales a lhs).
+     * @return instantánea publicada.
+     * @throws std::runtime_error Si alguna regla no es de lhs o no está en
+     *         FNC; en ese caso no se publica nada.
+     */
+    std::shared_ptr<const CompiledGrammar> ReplaceRules(const std::string& lhs,
+                                                        std::vector<Production> rules);
+
+    /**
+     * @brief Añade una producción a las de su LHS (si no la tenía ya).
+     */
+    std::shared_ptr<const CompiledGrammar> AddRule(const Production& rule);
+
+    /**
+     * @brief Quita una producción de las de su LHS (si la tenía).
+     */
+    std::shared_ptr<const CompiledGrammar> RemoveRule(const Production& rule);
+
+private:
+    /**
+     * @brief Producciones de lhs en la versión vigente (cerrojo ya tomado).
+     */
+    std::vector<Production> CurrentRules(const std::string& lhs) const;
+
+    /**
+     * @brief ReplaceRules() con el cerrojo de escritores ya tomado.
+     */
+    std::shared_ptr<const CompiledGrammar> Publish(const std::string& lhs, std::vector<Production> rules);
+
+    static constexpr size_t kCacheSlots = 8; // entradas de la caché de Snapshot() por hilo
+
+    const uint64_t id_; // distinto para cada publicador del proceso; nunca se reutiliza
+    std::mutex writers_; // serializa las ediciones (los lectores no lo usan)
+    std::shared_ptr<const CompiledGrammar> current_; // solo con std::atomic_load/std::atomic_store
+    std::atomic<uint64_t> published_{0}; // publicaciones hechas; se incrementa tras guardar current_
+};
+
+#endif
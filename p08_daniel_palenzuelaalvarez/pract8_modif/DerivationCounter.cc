@@ -0,0 +1,79 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: DerivationCounter.cc: Implementación de la cuenta de derivaciones.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file DerivationCounter.cc
+ * @brief Implementación de DerivationCounter.
+ */
+
+#include "DerivationCounter.h"
+
+#include <stdexcept>
+
+#include "Parallel.h"
+
+/**
+ * @brief Rellena la tabla N(A, l) longitud a longitud.
+ *
+ * La longitud 1 sale de las reglas unarias. Para l >= 2 cada no terminal es
+ * una tarea independiente, ya que solo lee valores de longitudes menores.
+ */
+DerivationCounter::DerivationCounter(const CNFIndex& index, size_t max_len, unsigned threads,
+                                     uint64_t modulus)
+    : max_len_(max_len),
+      counts_(static_cast<size_t>(index.NumNonTerminals()) * (max_len + 1)) {
+    if (modulus == 1 || modulus > 0xffffffffULL)
+        throw std::invalid_argument("El módulo debe estar en [2, 2^32).");
+
+    const size_t stride = max_len_ + 1;
+    const size_t n = static_cast<size_t>(index.NumNonTerminals());
+
+    // Reglas binarias agrupadas por A para que cada tarea recorra solo las suyas
+    std::vector<std::vector<BinaryRule>> by_lhs(n);
+    for (const auto& r : index.BinaryRules()) by_lhs[r.lhs].push_back(r);
+
+    // Longitud 1: una derivación por cada regla A -> a
+    if (max_len_ >= 1) {
+        for (const auto& r : index.UnaryRules()) counts_[r.lhs * stride + 1] += BigUnsigned(1);
+        if (modulus) {
+            for (size_t a = 0; a < n; ++a) counts_[a * stride + 1] = counts_[a * stride + 1].Mod(modulus);
+        }
+    }
+
+    // Longitudes >= 2: convolución de longitudes, en paralelo sobre los no terminales
+    for (size_t len = 2; len <= max_len_; ++len) {
+        ParallelFor(0, n, threads, [&](size_t a) {
+            BigUnsigned acc;
+            for (const auto& r : by_lhs[a]) {
+                const BigUnsigned* left = &counts_[r.left * stride];
+                const BigUnsigned* right = &counts_[r.right * stride];
+                for (size_t k = 1; k < len; ++k) {
+                    acc.AddProduct(left[k], right[len - k]);
+                }
+                if (modulus) acc = acc.Mod(modulus);
+            }
+            counts_[a * stride + len] = acc;
+        });
+    }
+}
+
+const BigUnsigned& DerivationCounter::Count(int nt, size_t len) const {
+    if (len > max_len_) throw std::out_of_range("Longitud fuera del rango calculado.");
+    return counts_[static_cast<size_t>(nt) * (max_len_ + 1) + len];
+}
+
+size_t DerivationCounter::MaxLength() const { return max_len_; }
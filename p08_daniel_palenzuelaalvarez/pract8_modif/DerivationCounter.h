@@ -0,0 +1,74 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: DerivationCounter.h: Cuenta de derivaciones por no terminal y longitud
+ *    sobre una gramática en FNC.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file DerivationCounter.h
+ * @brief Programación dinámica que cuenta los árboles de derivación de cada
+ *        longitud para cada no terminal de una gramática en FNC.
+ *
+ * Para A -> a se cuenta 1 en la longitud 1, y para A -> BC:
+ *   N(A, l) += sum_{k=1}^{l-1} N(B, k) * N(C, l - k)
+ * Si la gramática no es ambigua, el número de derivaciones coincide con el
+ * número de cadenas de esa longitud.
+ */
+
+#ifndef DERIVATION_COUNTER_H
+#define DERIVATION_COUNTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "BigUnsigned.h"
+#include "CYK.h"
+
+/**
+ * @class DerivationCounter
+ * @brief Tabla N(A, l) para todos los no terminales A y longitudes 1 <= l <= max_len.
+ *
+ * Para cada longitud, los no terminales se calculan en paralelo (la convolución
+ * de longitudes de A solo depende de longitudes menores). Con modulus != 0 los
+ * valores se reducen módulo modulus en cada celda.
+ */
+class DerivationCounter {
+public:
+    /**
+     * @brief Calcula la tabla de cuentas.
+     * @param index Índice de la gramática en FNC.
+     * @param max_len Longitud máxima a calcular.
+     * @param threads Número de hilos.
+     * @param modulus 0 para cuentas exactas, o módulo en [2, 2^32).
+     * @throws std::invalid_argument Si el módulo no es válido.
+     */
+    DerivationCounter(const CNFIndex& index, size_t max_len, unsigned threads, uint64_t modulus = 0);
+
+    /**
+     * @brief Número de derivaciones de cadenas de longitud len desde el no terminal nt.
+     */
+    const BigUnsigned& Count(int nt, size_t len) const;
+
+    /**
+     * @brief Longitud máxima calculada.
+     */
+    size_t MaxLength() const;
+
+private:
+    size_t max_len_;
+    std::vector<BigUnsigned> counts_; // counts_[nt * (max_len_ + 1) + len]
+};
+
+#endif
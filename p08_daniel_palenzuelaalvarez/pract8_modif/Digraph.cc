@@ -0,0 +1,100 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Digraph.cc: Implementación de los algoritmos sobre grafos dirigidos.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Digraph.cc
+ * @brief Implementación de StronglyConnectedComponents() y SolveSetEquations().
+ */
+
+#include "Digraph.h"
+
+#include <algorithm>
+#include <utility>
+
+int StronglyConnectedComponents(const std::vector<std::vector<int>>& adj, std::vector<int>& comp) {
+    const int n = static_cast<int>(adj.size());
+    std::vector<int> index(n, -1), low(n, 0);
+    std::vector<int> stack;
+    std::vector<bool> on_stack(n, false);
+    std::vector<std::pair<int, size_t>> call; // (vértice, siguiente arista)
+    comp.assign(n, -1);
+    int counter = 0, components = 0;
+
+    for (int root = 0; root < n; ++root) {
+        if (index[root] >= 0) continue;
+        call.emplace_back(root, 0);
+        while (!call.empty()) {
+            auto& [v, next] = call.back();
+            if (next == 0) {
+                index[v] = low[v] = counter++;
+                stack.push_back(v);
+                on_stack[v] = true;
+            }
+            if (next < adj[v].size()) {
+                int w = adj[v][next++];
+                if (index[w] < 0) {
+                    call.emplace_back(w, 0);
+                } else if (on_stack[w]) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+                continue;
+            }
+            // v terminado: cerrar su componente si es raíz y propagar low al padre
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = false;
+                    comp[w] = components;
+                } while (w != v);
+                ++components;
+            }
+            int done = v;
+            call.pop_back();
+            if (!call.empty()) low[call.back().first] = std::min(low[call.back().first], low[done]);
+        }
+    }
+    return components;
+}
+
+/**
+ * @brief Las componentes se procesan en el orden de StronglyConnectedComponents()
+ *        (primero las que no dependen de otras), y dentro de una componente
+ *        todos los vértices comparten el mismo conjunto, así que basta una pasada.
+ */
+void SolveSetEquations(const std::vector<std::vector<int>>& adj, size_t words, std::vector<uint64_t>& sets) {
+    std::vector<int> comp;
+    int components = StronglyConnectedComponents(adj, comp);
+    std::vector<std::vector<int>> members(components);
+    for (size_t v = 0; v < adj.size(); ++v) members[comp[v]].push_back(static_cast<int>(v));
+
+    std::vector<uint64_t> acc(words);
+    for (int c = 0; c < components; ++c) {
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int v : members[c]) {
+            const uint64_t* own = &sets[static_cast<size_t>(v) * words];
+            for (size_t k = 0; k < words; ++k) acc[k] |= own[k];
+            for (int w : adj[v]) {
+                if (comp[w] == c) continue;
+                const uint64_t* dep = &sets[static_cast<size_t>(w) * words];
+                for (size_t k = 0; k < words; ++k) acc[k] |= dep[k];
+            }
+        }
+        for (int v : members[c]) std::copy(acc.begin(), acc.end(), &sets[static_cast<size_t>(v) * words]);
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Digraph.h: Componentes fuertemente conexas y ecuaciones de conjuntos
+ *    sobre grafos dirigidos.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Digraph.h
+ * @brief Algoritmos sobre grafos dirigidos dados como listas de adyacencia.
+ *
+ * SolveSetEquations() es el algoritmo "digraph" de DeRemer y Pennello: dada
+ * una relación v -> w y un conjunto inicial por vértice, calcula el menor
+ * conjunto que cumple sets[v] ⊇ sets[w] para cada arista. Se usa para FIRST,
+ * FOLLOW y las lookaheads LALR(1).
+ */
+
+#ifndef DIGRAPH_H
+#define DIGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Componentes fuertemente conexas (Tarjan, iterativo).
+ * @param adj Lista de adyacencia.
+ * @param comp Componente de cada vértice (salida).
+ * @return número de componentes. Se numeran en orden topológico inverso: si
+ *         hay una arista u -> v entre componentes distintas, comp[u] > comp[v].
+ */
+int StronglyConnectedComponents(const std::vector<std::vector<int>>& adj, std::vector<int>& comp);
+
+/**
+ * @brief Resuelve sets[v] = sets[v] ∪ (∪ sets[w] para cada arista v -> w).
+ * @param adj Lista de adyacencia.
+ * @param words Palabras de 64 bits por conjunto.
+ * @param sets Conjuntos consecutivos, uno por vértice (entrada: iniciales; salida: solución).
+ */
+void SolveSetEquations(const std::vector<std::vector<int>>& adj, size_t words, std::vector<uint64_t>& sets);
+
+#endif
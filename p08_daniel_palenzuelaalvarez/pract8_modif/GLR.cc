@@ -0,0 +1,361 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: GLR.cc: Implementación del reconocedor GLR.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file GLR.cc
+ * @brief Implementación de GLRParser.
+ */
+
+#include "GLR.h"
+
+#include <deque>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Resultado de un paso en modo LR.
+ */
+enum class LRStep { kShifted, kAccepted, kRejected, kGeneral };
+
+/**
+ * @brief Estado del análisis de una cadena: la arena de nodos y aristas y los
+ *        datos del nivel en curso.
+ */
+class GSS {
+public:
+    GSS(const LALRTable& table, size_t expected_nodes) : table_(table), node_at_(table.NumStates(), -1) {
+        nodes_.reserve(expected_nodes);
+        edges_.reserve(expected_nodes);
+    }
+
+    /**
+     * @brief Aplica, hasta agotarlas, las reducciones del nivel level con el
+     *        terminal a como lookahead.
+     */
+    void Reduce(uint32_t level, int a) {
+        acted_ = 0;
+        inner_edges_ = false;
+        while (acted_ < frontier_.size() || !pending_.empty()) {
+            if (!pending_.empty()) {
+                auto [w, lhs] = pending_.front();
+                pending_.pop_front();
+                Reducer(level, a, w, lhs);
+                continue;
+            }
+            Actor(a, frontier_[acted_++]);
+        }
+    }
+
+    /**
+     * @brief Crea el nivel level + 1 con los desplazamientos del nivel actual.
+     * @return false si ningún nodo puede desplazar el terminal a.
+     */
+    bool Shift(uint32_t level, int a) {
+        std::vector<int32_t> current;
+        current.swap(frontier_);
+        level_edges_.clear();
+        for (int32_t v : current) node_at_[nodes_[v].state] = -1;
+        for (int32_t v : current) {
+            size_t count = 0;
+            const int32_t* acts = table_.Actions(nodes_[v].state, a, count);
+            // La acción de desplazamiento, si existe, es la primera de la celda
+            if (count == 0 || !LALRTable::IsShift(acts[0])) continue;
+            const int target = LALRTable::ShiftTarget(acts[0]);
+            int32_t u = node_at_[target];
+            if (u < 0) u = NewNode(target, level + 1);
+            AddEdge(u, v);
+        }
+        if (frontier_.size() == 1) EnterLR();
+        return lr_base_ >= 0 || !frontier_.empty();
+    }
+
+    /**
+     * @brief Indica si el análisis está en modo LR (una sola pila).
+     */
+    bool Deterministic() const { return lr_base_ >= 0; }
+
+    /**
+     * @brief Avanza en modo LR con el terminal a hasta desplazarlo, aceptar o
+     *        rechazar.
+     *
+     * La pila son los estados de lr_stack_ sobre el nodo lr_base_ de la GSS.
+     * Si una celda tiene varias acciones, la reducción es vacía o hay que
+     * desapilar por debajo de un nodo con varias aristas, la pila se pasa a
+     * la GSS y el nivel continúa con el algoritmo general (kGeneral).
+     */
+    LRStep StepLR(uint32_t level, int a) {
+        for (;;) {
+            const int top = lr_stack_.empty() ? nodes_[lr_base_].state : lr_stack_.back().state;
+            size_t count = 0;
+            const int32_t* acts = table_.Actions(top, a, count);
+            if (count == 0) return LRStep::kRejected;
+            if (count > 1) return Materialize();
+            if (LALRTable::IsShift(acts[0])) {
+                lr_stack_.push_back(GSSNode{LALRTable::ShiftTarget(acts[0]), level + 1, -1});
+                return LRStep::kShifted;
+            }
+            const int r = LALRTable::ReduceRule(acts[0]);
+            if (r == 0) return LRStep::kAccepted;
+            const size_t m = static_cast<size_t>(table_.RuleLength(r));
+            if (m == 0) return Materialize();
+            if (m <= lr_stack_.size()) {
+                lr_stack_.resize(lr_stack_.size() - m);
+            } else {
+                // Seguir desapilando en la GSS mientras sea lineal
+                int32_t x = lr_base_;
+                for (size_t k = lr_stack_.size(); k < m; ++k) {
+                    const int32_t e = nodes_[x].first_edge;
+                    if (e < 0 || edges_[e].next >= 0) return Materialize();
+                    x = edges_[e].target;
+                }
+                lr_stack_.clear();
+                lr_base_ = x;
+            }
+            const int below = lr_stack_.empty() ? nodes_[lr_base_].state : lr_stack_.back().state;
+            lr_stack_.push_back(GSSNode{table_.Goto(below, table_.RuleLhs(r)), level, -1});
+        }
+    }
+
+    bool Accepted() const { return accepted_; }
+
+    void Start() {
+        NewNode(0, 0);
+        EnterLR();
+    }
+
+    GLRStats Stats() const { return GLRStats{nodes_.size(), edges_.size()}; }
+
+private:
+    const LALRTable& table_;
+    std::vector<GSSNode> nodes_;      // arena de nodos
+    std::vector<GSSEdge> edges_;      // arena de aristas
+    std::vector<int32_t> node_at_;    // estado -> nodo del nivel actual (-1 si no hay)
+    std::vector<int32_t> frontier_;   // nodos del nivel actual, en orden de creación
+    size_t acted_ = 0;                // frontier_[0, acted_) ya han aplicado sus reducciones
+    bool inner_edges_ = false;        // hay aristas entre nodos del nivel actual
+    bool accepted_ = false;
+    std::deque<std::pair<int32_t, int>> pending_; // (nodo destino del camino, no terminal)
+    std::unordered_set<uint64_t> level_edges_;  // aristas (origen, destino) creadas en el nivel actual
+    std::vector<std::pair<int32_t, bool>> layer_, next_layer_; // recorrido de caminos por capas
+    std::vector<uint32_t> seen_, seen_used_; // nodo -> última capa en la que se ha visitado
+    uint32_t generation_ = 0;
+    int32_t lr_base_ = -1;           // nodo de la GSS bajo la pila LR (-1 fuera del modo LR)
+    std::vector<GSSNode> lr_stack_;  // pila LR: estado y nivel de cada entrada
+
+    /**
+     * @brief Pasa a modo LR con el único nodo del nivel actual como base.
+     */
+    void EnterLR() {
+        lr_base_ = frontier_[0];
+        node_at_[nodes_[lr_base_].state] = -1;
+        frontier_.clear();
+        lr_stack_.clear();
+    }
+
+    /**
+     * @brief Convierte la pila LR en una cadena de nodos de la GSS; la cima
+     *        queda como único nodo (sin procesar) del nivel actual.
+     */
+    LRStep Materialize() {
+        int32_t below = lr_base_;
+        for (const GSSNode& entry : lr_stack_) {
+            const int32_t id = AllocNode(entry.state, entry.level);
+            AddEdge(id, below);
+            below = id;
+        }
+        level_edges_.clear();
+        node_at_[nodes_[below].state] = below;
+        frontier_.assign(1, below);
+        lr_base_ = -1;
+        lr_stack_.clear();
+        return LRStep::kGeneral;
+    }
+
+    int32_t AllocNode(int state, uint32_t level) {
+        const int32_t id = static_cast<int32_t>(nodes_.size());
+        nodes_.push_back(GSSNode{state, level, -1});
+        seen_.push_back(0);
+        seen_used_.push_back(0);
+        return id;
+    }
+
+    int32_t NewNode(int state, uint32_t level) {
+        const int32_t id = AllocNode(state, level);
+        node_at_[state] = id;
+        frontier_.push_back(id);
+        return id;
+    }
+
+    int32_t AddEdge(int32_t from, int32_t to) {
+        const int32_t id = static_cast<int32_t>(edges_.size());
+        level_edges_.insert(EdgeKey(from, to));
+        edges_.push_back(GSSEdge{to, nodes_[from].first_edge});
+        nodes_[from].first_edge = id;
+        return id;
+    }
+
+    static uint64_t EdgeKey(int32_t from, int32_t to) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) | static_cast<uint32_t>(to);
+    }
+
+    /**
+     * @brief Encola una reducción a lhs por cada nodo al que se llega desde v
+     *        con exactamente m aristas (solo por caminos que pasan por la
+     *        arista via, si via >= 0).
+     *
+     * Para reconocer basta con el conjunto de nodos finales, así que los
+     * caminos se recorren por capas sin repetir (nodo, ha pasado por via):
+     * el coste es O(m * aristas) aunque el número de caminos sea exponencial.
+     */
+    void ReducePaths(int32_t v, int m, int32_t via, int lhs) {
+        int depth = 0;
+        if (via < 0) {
+            // Camino lineal: se sigue sin estructuras auxiliares
+            while (depth < m && nodes_[v].first_edge >= 0 && edges_[nodes_[v].first_edge].next < 0) {
+                v = edges_[nodes_[v].first_edge].target;
+                ++depth;
+            }
+            if (depth == m) {
+                pending_.emplace_back(v, lhs);
+                return;
+            }
+        }
+        layer_.assign(1, std::make_pair(v, via < 0));
+        for (; depth < m; ++depth) {
+            next_layer_.clear();
+            ++generation_;
+            for (const auto& [x, used] : layer_) {
+                for (int32_t e = nodes_[x].first_edge; e >= 0; e = edges_[e].next) {
+                    const int32_t y = edges_[e].target;
+                    const bool now = used || e == via;
+                    uint32_t& seen = now ? seen_used_[y] : seen_[y];
+                    if (seen == generation_) continue;
+                    seen = generation_;
+                    next_layer_.emplace_back(y, now);
+                }
+            }
+            layer_.swap(next_layer_);
+        }
+        for (const auto& [x, used] : layer_) {
+            if (used) pending_.emplace_back(x, lhs);
+        }
+    }
+
+    /**
+     * @brief Aplica todas las reducciones del nodo v con el terminal a.
+     */
+    void Actor(int a, int32_t v) {
+        size_t count = 0;
+        const int32_t* acts = table_.Actions(nodes_[v].state, a, count);
+        for (size_t i = 0; i < count; ++i) {
+            if (!LALRTable::IsReduce(acts[i])) continue;
+            const int r = LALRTable::ReduceRule(acts[i]);
+            if (r == 0) {
+                accepted_ = true;
+                continue;
+            }
+            ReducePaths(v, table_.RuleLength(r), -1, table_.RuleLhs(r));
+        }
+    }
+
+    /**
+     * @brief Añade el goto de w con lhs al nivel actual.
+     *
+     * Si el nodo destino ya existía y ya había aplicado sus reducciones, los
+     * caminos que empiezan por la arista nueva se reducen ahora. Si además hay
+     * aristas entre nodos del mismo nivel (reducciones vacías), la arista nueva
+     * puede estar en mitad de caminos de otros nodos ya procesados, que se
+     * vuelven a recorrer (corrección de Farshi).
+     */
+    void Reducer(uint32_t level, int a, int32_t w, int lhs) {
+        const int k = table_.Goto(nodes_[w].state, lhs);
+        int32_t u = node_at_[k];
+        if (nodes_[w].level == level) inner_edges_ = true;
+        if (u < 0) {
+            u = NewNode(k, level);
+            AddEdge(u, w);
+            return;
+        }
+        if (level_edges_.count(EdgeKey(u, w))) return;
+        const int32_t e = AddEdge(u, w);
+        if (!inner_edges_) {
+            // Solo los caminos de u pueden usar la arista, y empiezan por ella.
+            // Los nodos de frontier_ tienen ids crecientes: u ya actuó si su id
+            // no supera el del último nodo procesado.
+            if (acted_ == 0 || u > frontier_[acted_ - 1]) return;
+            size_t count = 0;
+            const int32_t* acts = table_.Actions(nodes_[u].state, a, count);
+            for (size_t j = 0; j < count; ++j) {
+                if (!LALRTable::IsReduce(acts[j])) continue;
+                const int r = LALRTable::ReduceRule(acts[j]);
+                if (r == 0 || table_.RuleLength(r) == 0) continue;
+                ReducePaths(w, table_.RuleLength(r) - 1, -1, table_.RuleLhs(r));
+            }
+            return;
+        }
+        for (size_t i = 0; i < acted_; ++i) {
+            const int32_t v = frontier_[i];
+            size_t count = 0;
+            const int32_t* acts = table_.Actions(nodes_[v].state, a, count);
+            for (size_t j = 0; j < count; ++j) {
+                if (!LALRTable::IsReduce(acts[j])) continue;
+                const int r = LALRTable::ReduceRule(acts[j]);
+                if (r == 0 || table_.RuleLength(r) == 0) continue;
+                ReducePaths(v, table_.RuleLength(r), e, table_.RuleLhs(r));
+            }
+        }
+    }
+};
+
+} // namespace
+
+GLRParser::GLRParser(const LALRTable& table) : table_(table) {}
+
+/**
+ * @brief Para cada posición: reducciones con el carácter siguiente como
+ *        lookahead y después desplazamiento al nivel siguiente; con el fin de
+ *        cadena solo se reduce, y se acepta si algún nodo reduce S' -> S.
+ *        Mientras haya una sola pila, cada posición se resuelve en modo LR.
+ */
+bool GLRParser::Accepts(const std::string& word, GLRStats* stats) const {
+    GSS gss(table_, 2 * word.size() + 16);
+    gss.Start();
+    bool accepted = false;
+    for (uint32_t level = 0;; ++level) {
+        const int a = level < word.size() ? table_.TerminalId(static_cast<unsigned char>(word[level]))
+                                          : table_.EndMarker();
+        if (a < 0) break;
+        if (gss.Deterministic()) {
+            const LRStep step = gss.StepLR(level, a);
+            if (step == LRStep::kShifted) continue;
+            if (step != LRStep::kGeneral) {
+                accepted = step == LRStep::kAccepted;
+                break;
+            }
+        }
+        gss.Reduce(level, a);
+        if (level == word.size()) {
+            accepted = gss.Accepted();
+            break;
+        }
+        if (!gss.Shift(level, a)) break;
+    }
+    if (stats) *stats = gss.Stats();
+    return accepted;
+}
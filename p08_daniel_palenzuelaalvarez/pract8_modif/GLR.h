@@ -0,0 +1,94 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: GLR.h: Reconocedor GLR (Tomita) con pila estructurada en grafo.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+ *    M. Tomita. Efficient Parsing for Natural Language. Kluwer, 1986.
+ *    R. Nozohoor-Farshi. GLR Parsing for epsilon-Grammars. 1991.
+*/
+
+/**
+ * @file GLR.h
+ * @brief Análisis LR generalizado sobre las tablas LALR(1) con conflictos.
+ *
+ * Cada celda de la tabla puede tener varias acciones; en lugar de duplicar la
+ * pila, todas las pilas posibles se guardan en un grafo (GSS) cuyos nodos son
+ * (estado, nivel) y cuyas aristas apuntan hacia el fondo de la pila. En cada
+ * nivel hay a lo sumo un nodo por estado.
+ */
+
+#ifndef GLR_H
+#define GLR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LALR.h"
+
+/**
+ * @brief Nodo de la pila: estado LR, nivel (posición en la cadena) y primera
+ *        arista de su lista.
+ */
+struct GSSNode {
+    int32_t state;
+    uint32_t level;
+    int32_t first_edge; // -1 si no tiene aristas
+};
+
+/**
+ * @brief Arista de la pila hacia un nodo más profundo; las aristas de un mismo
+ *        nodo forman una lista enlazada dentro de la arena.
+ */
+struct GSSEdge {
+    int32_t target;
+    int32_t next; // siguiente arista del mismo nodo (-1 si es la última)
+};
+
+/**
+ * @brief Tamaño de la pila tras analizar una cadena.
+ */
+struct GLRStats {
+    size_t nodes = 0;
+    size_t edges = 0;
+};
+
+/**
+ * @class GLRParser
+ * @brief Reconocedor GLR dirigido por la lista completa de acciones de cada
+ *        celda de LALRTable.
+ *
+ * Mientras la pila es lineal y cada celda tiene una sola acción, un nivel
+ * tiene un único nodo activo y las reducciones recorren una sola arista por
+ * símbolo, así que el coste por carácter es el de un analizador LR.
+ */
+class GLRParser {
+public:
+    /**
+     * @brief Prepara el reconocedor (las tablas no se copian y deben seguir vivas).
+     */
+    explicit GLRParser(const LALRTable& table);
+
+    /**
+     * @brief Decide si la cadena pertenece al lenguaje de la gramática.
+     * @param word Cadena de entrada.
+     * @param stats Si no es nulo, recibe el tamaño final de la pila.
+     */
+    bool Accepts(const std::string& word, GLRStats* stats = nullptr) const;
+
+private:
+    const LALRTable& table_;
+};
+
+#endif
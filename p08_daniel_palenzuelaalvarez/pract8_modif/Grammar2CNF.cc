@@ -29,6 +29,8 @@
 
 #include "Grammar2CNF.h"
 
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -36,12 +38,42 @@
 #include <iomanip>
 #include <algorithm>
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <tuple>
+
+#include "Digraph.h"
+#include "Parallel.h"
+#include "SpscQueue.h"
 
 using std::string;
 using std::vector;
 using std::map;
 using std::set;
 
+/**
+ * @brief Función hash para las claves de producción (vectores de ids internados).
+ */
+struct ProductionKeyHash {
+    size_t operator()(const vector<int>& key) const {
+        uint64_t h = 1469598103934665603ULL; // FNV-1a sobre los ids
+        for (int v : key) {
+            h ^= static_cast<uint32_t>(v);
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * @brief Conjunto hash de producciones ya vistas.
+ */
+using ProductionKeySet = std::unordered_set<vector<int>, ProductionKeyHash>;
+
 /**
  * @brief Constructor por defecto.
  *
@@ -65,49 +97,170 @@ static void TrimString(string &s) {
 }
 
 /**
- * @brief Lee una gramática desde un fichero en formato .gra.
- * @param path Ruta del fichero de entrada.
+ * @brief Lee una línea no vacía con un entero.
+ * @param is Flujo de entrada.
+ * @param out Entero leído (salida).
+ * @throws std::runtime_error Si la línea no es un número o se acaba el fichero.
+ */
+static void ReadIntLine(std::istream& is, int& out) {
+    string line;
+    while (std::getline(is, line)) {
+        TrimString(line); // quitar espacios alrededor
+        if (line.empty()) continue; // ignorar líneas vacías
+        std::istringstream iss(line);
+        if (iss >> out) return; // leído correctamente
+        // si no se pudo parsear como entero, error
+        throw std::runtime_error("Formato inválido: se esperaba un número en una línea específica.");
+    }
+    // Si llegamos al EOF sin leer el número
+    throw std::runtime_error("Formato inválido: archivo terminado inesperadamente al leer número.");
+}
+
+/**
+ * @brief Indica si c separa símbolos en una RHS.
+ */
+static bool IsBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * @brief Lee la siguiente producción del fichero .gra y la divide en símbolos.
  *
- * @throws std::runtime_error Si el fichero no existe o el formato es inválido.
+ * La RHS se recorre una sola vez, de izquierda a derecha, sin retroceder:
+ *  - los espacios separan símbolos;
+ *  - <Nombre> es un no terminal si Nombre está declarado;
+ *  - "texto" o 'texto' es una secuencia de terminales, uno por carácter
+ *    (salvo que la comilla sea un terminal declarado); así se escriben los
+ *    terminales en mayúscula y el terminal '&';
+ *  - una palabra igual a un no terminal declarado es ese no terminal; si no,
+ *    cada carácter es un símbolo (mayúscula -> no terminal, resto -> terminal),
+ *    que es el formato original de la práctica.
+ *
+ * @param is Flujo de entrada, situado en la sección de producciones.
+ * @return producción leída (la RHS "&" se guarda como un único token "&").
+ * @throws std::runtime_error Si faltan producciones o la línea es inválida.
  */
-void Grammar::ReadFromFile(const string& path) {
-    // Abrir fichero de entrada
-    std::ifstream ifs(path);
-    if (!ifs) {
-        throw std::runtime_error("No se pudo abrir el fichero de entrada: " + path);
+Production Grammar::ReadProductionLine(std::istream& is) const {
+    string line;
+    do {
+        if (!std::getline(is, line)) throw std::runtime_error("Formato inválido: faltan producciones.");
+        TrimString(line);
+    } while (line.empty()); // tolera líneas vacías
+
+    // LHS: <Nombre> o la primera palabra
+    Production prod;
+    size_t i = 0;
+    if (line[0] == '<' && line.find('>') != string::npos) {
+        size_t close = line.find('>');
+        prod.lhs = line.substr(1, close - 1);
+        i = close + 1;
+    } else {
+        while (i < line.size() && !IsBlank(line[i])) ++i;
+        prod.lhs = line.substr(0, i);
+    }
+    while (i < line.size() && IsBlank(line[i])) ++i;
+    if (i == line.size()) throw std::runtime_error("Formato inválido en producción (falta RHS): '" + line + "'");
+
+    // Tokenización de RHS
+    if (line.compare(i, string::npos, "&") == 0) {
+        // producción vacía
+        prod.rhs.push_back("&");
+        return prod;
+    }
+    while (i < line.size()) {
+        char c = line[i];
+        if (IsBlank(c)) {
+            ++i;
+        } else if (c == '<' && line.find('>', i + 1) != string::npos &&
+                   IsInputNonTerminal(line.substr(i + 1, line.find('>', i + 1) - i - 1))) {
+            // no terminal delimitado
+            size_t close = line.find('>', i + 1);
+            prod.rhs.push_back(line.substr(i + 1, close - i - 1));
+            i = close + 1;
+        } else if ((c == '"' || c == '\'') && !input_terminals_[static_cast<unsigned char>(c)] && line.find(c, i + 1) != string::npos) {
+            // terminales entre comillas, uno por carácter; se marcan los que
+            // sin comillas se leerían como no terminal o como cadena vacía
+            size_t close = line.find(c, i + 1);
+            if (close == i + 1) throw std::runtime_error("Formato inválido en producción (terminal vacío): '" + line + "'");
+            for (size_t k = i + 1; k < close; ++k) {
+                if (NeedsQuotes(line[k])) {
+                    prod.quoted.resize(prod.rhs.size());
+                    prod.quoted.push_back(true);
+                }
+                prod.rhs.push_back(string(1, line[k]));
+            }
+            i = close + 1;
+        } else {
+            // palabra hasta el siguiente separador o delimitador
+            size_t j = i + 1;
+            while (j < line.size() && !IsBlank(line[j]) && line[j] != '<' && line[j] != '"' && line[j] != '\'') ++j;
+            string word = line.substr(i, j - i);
+            if (word.size() > 1 && IsInputNonTerminal(word)) {
+                prod.rhs.push_back(word);
+            } else {
+                // cada carácter es un símbolo: mayúscula -> no terminal, resto -> terminal
+                for (char w : word) prod.rhs.push_back(string(1, w));
+            }
+            i = j;
+        }
     }
+    if (!prod.quoted.empty()) prod.quoted.resize(prod.rhs.size());
+    return prod;
+}
 
+/**
+ * @brief Indica si name es un no terminal declarado en la entrada.
+ *
+ * Los no terminales de la entrada son los primeros símbolos internados, así
+ * que basta comparar su id con el número de declarados.
+ */
+bool Grammar::IsInputNonTerminal(const string& name) const {
+    auto it = symbol_ids_.find(name);
+    return it != symbol_ids_.end() && it->second < num_input_nonterminals_;
+}
+
+/**
+ * @brief Reinicia la gramática y lee la cabecera del fichero .gra
+ *        (terminales, no terminales y número de producciones).
+ *
+ * Un terminal puede escribirse entre comillas ("a" o "if"); en ese caso
+ * cada carácter es un terminal. Un no terminal puede escribirse como
+ * <Nombre>. Los no terminales se internan en orden de declaración, de modo
+ * que el símbolo de arranque tiene id 0.
+ *
+ * @param is Flujo de entrada.
+ * @return número de producciones anunciado en la cabecera.
+ * @throws std::runtime_error Si el formato es inválido.
+ */
+int Grammar::ReadHeader(std::istream& is) {
     // Reiniciar estructuras internas antes de leer
     terminals_.clear();
     nonterminals_.clear();
     productions_.clear();
     terminal_to_nt_.clear();
+    source_productions_.clear();
+    aux_origin_.clear();
+    symbol_ids_.clear();
+    symbol_names_.clear();
+    num_input_nonterminals_ = 0;
+    input_terminals_.fill(false);
+    extended_syntax_ = false;
     counter_d_ = 0;
     start_symbol_.clear();
 
-    // Función auxiliar para leer una línea con un entero
-    auto read_int_line = [&](int &out) {
-        string line;
-        while (std::getline(ifs, line)) {
-            TrimString(line); // quitar espacios alrededor
-            if (line.empty()) continue; // ignorar líneas vacías
-            std::istringstream iss(line);
-            if (iss >> out) return; // leído correctamente
-            // si no se pudo parsear como entero, error
-            throw std::runtime_error("Formato inválido: se esperaba un número en una línea específica.");
-        }
-        // Si llegamos al EOF sin leer el número
-        throw std::runtime_error("Formato inválido: archivo terminado inesperadamente al leer número.");
-    };
-
     // 1) leer terminals
     int n_terms = 0;
-    read_int_line(n_terms); // lee número de terminales
+    ReadIntLine(is, n_terms); // lee número de terminales
     for (int i = 0; i < n_terms; ++i) {
         string line;
-        if (!std::getline(ifs, line)) throw std::runtime_error("Formato inválido: faltan símbolos terminales.");
+        if (!std::getline(is, line)) throw std::runtime_error("Formato inválido: faltan símbolos terminales.");
         TrimString(line);
         if (line.empty()) { --i; continue; } // tolerar líneas vacías intercaladas
+        if (line.size() > 2 && (line[0] == '"' || line[0] == '\'') && line.back() == line[0]) {
+            // terminales entre comillas: uno por carácter
+            for (size_t k = 1; k + 1 < line.size(); ++k) terminals_.insert(line[k]);
+            continue;
+        }
         if (line.size() != 1) {
             // cada terminal en entrada debe ser un único carácter
             throw std::runtime_error("Formato inválido: cada símbolo terminal debe ser un único carácter (línea: '" + line + "').");
@@ -118,63 +271,86 @@ void Grammar::ReadFromFile(const string& path) {
 
     // 2) leer nonterminals
     int n_nt = 0;
-    read_int_line(n_nt); // lee número de no terminales
+    ReadIntLine(is, n_nt); // lee número de no terminales
     vector<string> nt_list;
     for (int i = 0; i < n_nt; ++i) {
         string line;
-        if (!std::getline(ifs, line)) throw std::runtime_error("Formato inválido: faltan símbolos no terminales.");
+        if (!std::getline(is, line)) throw std::runtime_error("Formato inválido: faltan símbolos no terminales.");
         TrimString(line);
         if (line.empty()) { --i; continue; } // tolera líneas vacías
+        if (line.size() > 2 && line.front() == '<' && line.back() == '>') line = line.substr(1, line.size() - 2);
+        if (line.size() > 1) extended_syntax_ = true;
+        if (!nonterminals_.insert(line).second) continue; // declarado dos veces
         nt_list.push_back(line); // guardar orden para obtener símbolo inicial
-        nonterminals_.insert(line); // insertar en conjunto de no terminales
+        InternSymbol(line);
     }
     if (!nt_list.empty()) start_symbol_ = nt_list[0];
     // Si no hay no terminales, lanzar error
     else throw std::runtime_error("Formato inválido: no hay no terminales definidos.");
+    num_input_nonterminals_ = static_cast<int>(nt_list.size());
+    for (char t : terminals_) input_terminals_[static_cast<unsigned char>(t)] = true;
 
-    // 3) leer productions
+    // 3) número de producciones
     int pcount = 0;
-    read_int_line(pcount); // número de producciones
+    ReadIntLine(is, pcount);
+    return pcount;
+}
+
+/**
+ * @brief Lee una gramática desde un fichero en formato .gra.
+ * @param path Ruta del fichero de entrada.
+ *
+ * @throws std::runtime_error Si el fichero no existe o el formato es inválido.
+ */
+void Grammar::ReadFromFile(const string& path) {
+    // Abrir fichero de entrada
+    std::ifstream ifs(path);
+    if (!ifs) {
+        throw std::runtime_error("No se pudo abrir el fichero de entrada: " + path);
+    }
+
+    int pcount = ReadHeader(ifs);
+    // Leer producciones (las repetidas se descartan)
+    ProductionKeySet seen;
     for (int i = 0; i < pcount; ++i) {
-        string line;
-        if (!std::getline(ifs, line)) throw std::runtime_error("Formato inválido: faltan producciones.");
-        TrimString(line);
-        if (line.empty()) { --i; continue; } // tolera líneas vacías
+        Production prod = ReadProductionLine(ifs);
+        // Añadir producción al vector de producciones si no estaba ya
+        if (seen.insert(ProductionKey(prod)).second) productions_.push_back(prod);
+    }
+}
 
-        // parsear línea de producción: LHS -> RHS
-        std::istringstream iss(line);
-        string left;
-        if (!(iss >> left)) throw std::runtime_error("Formato inválido en producción: '" + line + "'");
-        string rhs_all;
-        if (!(iss >> rhs_all)) throw std::runtime_error("Formato inválido en producción (falta RHS): '" + line + "'");
-
-        // construir producción
-        Production prod;
-        prod.lhs = left;
-
-        // Tokenización de RHS
-        if (rhs_all == "&") {
-            // producción vacía
-            prod.rhs.push_back("&");
-        } else {
-            size_t idx = 0;
-            while (idx < rhs_all.size()) {
-                char c = rhs_all[idx];
-                // Si es mayúscula -> no terminal de la entrada
-                if (std::isupper(static_cast<unsigned char>(c))) {
-                    prod.rhs.push_back(std::string(1, c));
-                    ++idx;
-                } else {
-                    // terminal: siempre un único carácter de longitud 1
-                    prod.rhs.push_back(std::string(1, c));
-                    ++idx;
-                }
-            }
+/**
+ * @brief Escribe una producción como una línea del fichero .gra.
+ *
+ * Si la entrada usaba no terminales de varios caracteres, los símbolos de la
+ * RHS se separan con espacios para que el fichero se pueda volver a leer.
+ *
+ * @param os Flujo de salida.
+ * @param p Producción a escribir.
+ */
+void Grammar::WriteProduction(std::ostream& os, const Production& p) const {
+    // LHS + espacio + RHS concatenada
+    os << p.lhs << " ";
+    if (p.IsEmpty()) {
+        // epsilon representado por &
+        os << "&";
+    } else if (!p.quoted.empty()) {
+        // terminales marcados entre comillas (la comilla simple si '"' es terminal)
+        char quote = terminals_.count('"') ? '\'' : '"';
+        const char* sep = extended_syntax_ ? " " : "";
+        for (size_t i = 0; i < p.rhs.size(); ++i) {
+            os << (i ? sep : "");
+            if (p.IsQuoted(i)) os << quote << p.rhs[i] << quote;
+            else os << p.rhs[i];
         }
-
-        // Añadir producción al vector de producciones
-        productions_.push_back(prod);
+    } else if (extended_syntax_) {
+        // separar con espacios, por ejemplo Expr Ca D1 -> "Expr Ca D1"
+        for (size_t i = 0; i < p.rhs.size(); ++i) os << (i ? " " : "") << p.rhs[i];
+    } else {
+        // concatenar RHS, por ejemplo A B C -> "ABC"
+        os << RhsToString(p.rhs);
     }
+    os << "\n";
 }
 
 /**
@@ -203,18 +379,93 @@ void Grammar::WriteToFile(const string& path) const {
 
     // Escribir número de producciones y cada producción en una línea
     ofs << productions_.size() << "\n";
-    for (const auto& p : productions_) {
-        // LHS + espacio + RHS concatenada
-        ofs << p.lhs << " ";
-        if (p.rhs.size() == 1 && p.rhs[0] == "&") {
-            // epsilon representado por &
-            ofs << "&";
+    for (const auto& p : productions_) WriteProduction(ofs, p);
+}
+
+/**
+ * @brief Tablas de 256 entradas con las clases de caracteres declaradas.
+ */
+struct SymbolClasses {
+    std::array<bool, 256> terminal{};    // byte -> es un terminal declarado
+    std::array<bool, 256> nonterminal{}; // byte -> es un no terminal declarado (una letra)
+    std::unordered_set<string> names;    // no terminales de varios caracteres (copia propia)
+};
+
+/**
+ * @brief Valida los símbolos declarados y construye sus tablas de clases.
+ *
+ * El resultado no apunta a los conjuntos de la gramática: ConvertPipelined()
+ * lo usa en el hilo lector mientras la conversión añade los Ca.
+ *
+ * @param terminals Terminales declarados.
+ * @param nonterminals No terminales declarados.
+ * @throws std::runtime_error Si algún símbolo no cumple el convenio de la entrada.
+ */
+static SymbolClasses ClassifySymbols(const std::set<char>& terminals, const std::set<string>& nonterminals) {
+    // Validar terminales: no deben ser caracteres de control
+    SymbolClasses classes;
+    for (char t : terminals) {
+        if (std::iscntrl(static_cast<unsigned char>(t)))
+            throw std::runtime_error("Terminal inválido (carácter de control encontrado).");
+        classes.terminal[static_cast<unsigned char>(t)] = true;
+    }
+
+    // Validar no terminales: una mayúscula seguida de caracteres visibles que no
+    // sean delimitadores (así también se pueden releer los Ca de la salida);
+    // D seguido solo de dígitos queda reservado para los auxiliares Dk
+    for (const auto& nt : nonterminals) {
+        bool valid = !nt.empty() && std::isupper(static_cast<unsigned char>(nt[0]));
+        for (size_t i = 1; valid && i < nt.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(nt[i]);
+            valid = std::isgraph(c) && c != '<' && c != '>' && c != '"' && c != '\'';
+        }
+        if (!valid) {
+            throw std::runtime_error("Formato inválido: en la entrada, cada no terminal debe empezar por una letra mayúscula, sin espacios, '<', '>' ni comillas. Encontrado: '" + nt + "'.");
+        }
+        if (nt.size() > 1 && nt[0] == 'D' && nt.find_first_not_of("0123456789", 1) == string::npos) {
+            throw std::runtime_error("Formato inválido: el nombre '" + nt + "' está reservado para los no terminales auxiliares.");
+        }
+        if (nt.size() == 1 && classes.terminal[static_cast<unsigned char>(nt[0])]) {
+            throw std::runtime_error("Formato inválido: '" + nt + "' está declarado como terminal y como no terminal.");
+        }
+        if (nt.size() == 1) classes.nonterminal[static_cast<unsigned char>(nt[0])] = true;
+        else classes.names.insert(nt);
+    }
+    return classes;
+}
+
+/**
+ * @brief Comprueba que una producción solo use símbolos declarados.
+ * @return mensaje de error, o cadena vacía si la producción es correcta.
+ */
+static string ProductionFormatError(const Production& p, const SymbolClasses& classes) {
+    auto declared_nt = [&](const string& s) {
+        if (s.size() == 1) return classes.nonterminal[static_cast<unsigned char>(s[0])];
+        return classes.names.count(s) > 0;
+    };
+    // LHS debe estar declarado
+    if (!declared_nt(p.lhs)) return "Producción con LHS no declarado: '" + p.lhs + "'.";
+    // RHS puede ser epsilon
+    if (p.IsEmpty()) return "";
+
+    // Para cada token en RHS: o es un no terminal declarado o un terminal declarado
+    for (size_t k = 0; k < p.rhs.size(); ++k) {
+        const string& tok = p.rhs[k];
+        if (tok.empty()) return "Producción con token vacío en RHS.";
+        unsigned char c = static_cast<unsigned char>(tok[0]);
+        if (p.IsQuoted(k)) {
+            // terminal entre comillas: no depende de si es mayúscula
+            if (!classes.terminal[c]) return "Terminal en RHS no declarado: '" + tok + "'.";
+        } else if (std::isupper(c)) {
+            // token empieza por mayúscula => no terminal
+            if (!declared_nt(tok)) return "Producción con no terminal en RHS no declarado: '" + tok + "'.";
         } else {
-            // concatenar RHS, por ejemplo A B C -> "ABC"
-            ofs << RhsToString(p.rhs);
+            // token terminal debe ser de longitud 1 y estar declarado
+            if (tok.size() != 1) return "Terminal en RHS necesita ser un único carácter: '" + tok + "'.";
+            if (!classes.terminal[c]) return "Terminal en RHS no declarado: '" + tok + "'.";
         }
-        ofs << "\n";
     }
+    return "";
 }
 
 /**
@@ -222,48 +473,55 @@ void Grammar::WriteToFile(const string& path) const {
  *
  * Revisa:
  *  - que los terminales sean caracteres imprimibles
- *  - que los no terminales de la entrada sean una única letra mayúscula
+ *  - que cada no terminal de la entrada empiece por una letra mayúscula y
+ *    siga con caracteres visibles distintos de '<', '>' y comillas, sin
+ *    usar los nombres D1, D2... reservados a los auxiliares
  *  - que las producciones se refieran a símbolos declarados.
  *
+ * Las producciones se revisan en paralelo por fragmentos consecutivos; cada
+ * fragmento guarda su primer error y se informa del de menor línea, así que
+ * el mensaje es el mismo que con un solo hilo.
+ *
  * @throws std::runtime_error en caso de error de formato.
  */
-void Grammar::ValidateFormat() const {
-    // Validar terminales: no deben ser caracteres de control
-    for (char t : terminals_) {
-        if (std::iscntrl(static_cast<unsigned char>(t)))
-            throw std::runtime_error("Terminal inválido (carácter de control encontrado).");
-    }
-
-    // Validar no terminales: en la entrada deben ser exactamente una letra mayúscula
-    for (const auto& nt : nonterminals_) {
-        if (nt.size() != 1 || !std::isupper(static_cast<unsigned char>(nt[0]))) {
-            throw std::runtime_error("Formato inválido: en la entrada, cada no terminal debe ser una única letra mayúscula. Encontrado: '" + nt + "'.");
-        }
-    }
+void Grammar::ValidateFormat(unsigned threads) const {
+    SymbolClasses classes = ClassifySymbols(terminals_, nonterminals_);
 
     // Validar que las producciones refieran símbolos declarados
-    for (const auto& p : productions_) {
-        // LHS debe estar declarado
-        if (nonterminals_.find(p.lhs) == nonterminals_.end())
-            throw std::runtime_error("Producción con LHS no declarado: '" + p.lhs + "'.");
-        // RHS puede ser epsilon
-        if (p.rhs.size() == 1 && p.rhs[0] == "&") continue;
-
-        // Para cada token en RHS: o es un no terminal declarado o un terminal declarado
-        for (const auto& tok : p.rhs) {
-            if (tok.empty()) throw std::runtime_error("Producción con token vacío en RHS.");
-            if (std::isupper(static_cast<unsigned char>(tok[0]))) {
-                // token empieza por mayúscula => no terminal
-                if (nonterminals_.find(tok) == nonterminals_.end())
-                    throw std::runtime_error("Producción con no terminal en RHS no declarado: '" + tok + "'.");
-            } else {
-                // token terminal debe ser de longitud 1 y estar declarado
-                if (tok.size() != 1) throw std::runtime_error("Terminal en RHS necesita ser un único carácter: '" + tok + "'.");
-                if (terminals_.find(tok[0]) == terminals_.end())
-                    throw std::runtime_error("Terminal en RHS no declarado: '" + tok + "'.");
-            }
+    const size_t kShardSize = 4096;
+    const size_t n = productions_.size();
+    const size_t shards = (n + kShardSize - 1) / kShardSize;
+    vector<string> errors(shards);           // primer error de cada fragmento
+    std::atomic<size_t> first_bad(shards);   // menor fragmento con error
+    ParallelFor(0, shards, threads, [&](size_t s) {
+        // Un fragmento posterior a uno con error no puede aportar el primero
+        if (s > first_bad.load(std::memory_order_relaxed)) return;
+        size_t hi = std::min(n, (s + 1) * kShardSize);
+        for (size_t i = s * kShardSize; i < hi; ++i) {
+            string err = ProductionFormatError(productions_[i], classes);
+            if (err.empty()) continue;
+            errors[s] = std::move(err);
+            size_t cur = first_bad.load(std::memory_order_relaxed);
+            while (s < cur && !first_bad.compare_exchange_weak(cur, s, std::memory_order_relaxed)) {}
+            return;
         }
+    });
+    if (first_bad.load() < shards) throw std::runtime_error(errors[first_bad.load()]);
+}
+
+/**
+ * @brief Comprueba que una producción no sea vacía ni unitaria.
+ * @return mensaje de error, o cadena vacía si la producción es válida para el Algoritmo 1.
+ */
+static string PreconditionError(const Production& p) {
+    if (p.IsEmpty())
+        return "La gramática contiene la producción vacía: " + p.lhs + " -> &. Abortando.";
+    if (p.rhs.size() == 1 && !p.IsQuoted(0)) {
+        const string &tok = p.rhs[0];
+        if (!tok.empty() && std::isupper(static_cast<unsigned char>(tok[0])))
+            return "La gramática contiene una producción unitaria: " + p.lhs + " -> " + tok + ". Abortando.";
     }
+    return "";
 }
 
 /**
@@ -276,16 +534,12 @@ void Grammar::ValidateFormat() const {
 void Grammar::CheckPreconditions() const {
     // Buscar producciones epsilon
     for (const auto& p : productions_) {
-        if (p.rhs.size() == 1 && p.rhs[0] == "&")
-            throw std::runtime_error("La gramática contiene la producción vacía: " + p.lhs + " -> &. Abortando.");
+        if (p.IsEmpty()) throw std::runtime_error(PreconditionError(p));
     }
     // Buscar producciones unitarias A -> B
     for (const auto& p : productions_) {
-        if (p.rhs.size() == 1) {
-            const string &tok = p.rhs[0];
-            if (!tok.empty() && std::isupper(static_cast<unsigned char>(tok[0])))
-                throw std::runtime_error("La gramática contiene una producción unitaria: " + p.lhs + " -> " + tok + ". Abortando.");
-        }
+        string err = PreconditionError(p);
+        if (!err.empty()) throw std::runtime_error(err);
     }
 }
 
@@ -314,8 +568,19 @@ std::string Grammar::TerminalToNonTerminal(char t) {
     auto it = terminal_to_nt_.find(t);
     if (it != terminal_to_nt_.end()) return it->second;
 
+    // Con clases de terminales, el no terminal representa a toda la clase de t
+    // y se nombra por su primer miembro
+    vector<char> members(1, t);
+    if (group_terminals_) {
+        int cls = terminal_class_[static_cast<unsigned char>(t)];
+        members.clear();
+        for (char m : terminals_) {
+            if (terminal_class_[static_cast<unsigned char>(m)] == cls) members.push_back(m);
+        }
+    }
+
     // Crear nombre base para el no terminal auxiliar: "C" + carácter (ej. "Ca")
-    std::string name = std::string("C") + t;
+    std::string name = std::string("C") + members[0];
 
     // Asegurar que sea único, si ya existe añadir sufijo numérico incrementando
     int suffix = 1;
@@ -327,18 +592,20 @@ std::string Grammar::TerminalToNonTerminal(char t) {
 
     // Insertar nuevo no terminal
     nonterminals_.insert(name);
-    // Guardar en el mapa para futuras consultas
-    terminal_to_nt_[t] = name;
+    for (char m : members) {
+        // Guardar en el mapa para futuras consultas
+        terminal_to_nt_[m] = name;
 
-    // Añadir la producción <name> -> t
-    Production p;
-    p.lhs = name;
-    p.rhs.clear();
-    p.rhs.push_back(std::string(1, t));
-    productions_.push_back(p);
+        // Añadir la producción <name> -> m
+        Production p;
+        p.lhs = name;
+        p.rhs.push_back(std::string(1, m));
+        if (NeedsQuotes(m)) p.quoted.push_back(true);
+        productions_.push_back(p);
 
-    // Asegurarse de que el terminal esté registrado
-    terminals_.insert(t);
+        // Asegurarse de que el terminal esté registrado
+        terminals_.insert(m);
+    }
 
     return name;
 }
@@ -354,72 +621,522 @@ std::string Grammar::RhsToString(const std::vector<std::string>& rhs) {
     return out;
 }
 
+/**
+ * @brief Segundo paso del Algoritmo 1 para una producción: si m >= 3 la
+ *        descompone en A -> B1 D1, D_i -> B_{i+1} D_{i+1}, D_{m-2} -> B_{m-1} B_m;
+ *        si no, la copia tal cual.
+ * @param p Producción (con los terminales ya sustituidos si m >= 2).
+ * @param new_d Función que devuelve el nombre del siguiente Dk.
+ * @param record Función record(Dk, posición) para anotar el sufijo que genera cada Dk.
+ * @param out Vector donde se añaden las producciones resultantes.
+ */
+template <class NewName, class Record>
+static void BinarizeProduction(const Production& p, NewName new_d, Record record, vector<Production>& out) {
+    if (p.rhs.size() < 3) {
+        // Producción con m < 3, se mantiene igual
+        out.push_back(p);
+        return;
+    }
+    // m = longitud de RHS
+    size_t m = p.rhs.size();
+
+    // primera producción: A -> B1 D1
+    Production first;
+    first.lhs = p.lhs;
+    first.rhs.push_back(p.rhs[0]); // B1
+    std::string prevD = new_d(); // D1
+    record(prevD, size_t(1)); // D1 genera B2...Bm
+    first.rhs.push_back(prevD); // A -> B1 D1
+    out.push_back(first);
+
+    // Crear producciones intermedias D_i -> B_{i+1} D_{i+1}
+    for (size_t i = 1; i < m - 2; ++i) {
+        Production mid;
+        mid.lhs = prevD; // D_i
+        mid.rhs.push_back(p.rhs[i]); // B_{i+1}
+        std::string nextD = new_d(); // D_{i+1}
+        record(nextD, i + 1); // D_{i+1} genera B_{i+2}...B_m
+        mid.rhs.push_back(nextD);
+        out.push_back(mid);
+        prevD = nextD; // avanzar el puntero de D
+    }
+
+    // Última producción: D_{m-2} -> B_{m-1} B_m
+    Production last;
+    last.lhs = prevD; // D_{m-2}
+    last.rhs.push_back(p.rhs[m - 2]); // B_{m-1}
+    last.rhs.push_back(p.rhs[m - 1]); // B_m
+    out.push_back(last);
+}
+
 /**
  * @brief Aplica el Algoritmo 1 para transformar la gramática a Forma Normal de Chomsky.
  */
 void Grammar::TransformToCNF() {
+    // Guardar las producciones originales para poder relacionar el resultado con ellas
+    source_productions_ = productions_;
+    aux_origin_.clear();
+    if (group_terminals_) TerminalClasses(terminal_class_);
+
     // Primer loop: reemplazar terminales en producciones con m >= 2
     size_t original_size = productions_.size();
     for (size_t i = 0; i < original_size; ++i) {
-        Production &p = productions_[i];
         // Solo nos interesa cuando RHS tiene 2 o más símbolos
-        if (p.rhs.size() >= 2) {
-            for (std::string &tok : p.rhs) {
+        if (productions_[i].rhs.size() >= 2) {
+            for (size_t k = 0; k < productions_[i].rhs.size(); ++k) {
                 // Si es un terminal, reemplazar por no terminal auxiliar
-                if (tok.size() == 1 && !std::isupper(static_cast<unsigned char>(tok[0]))) {
-                    char t = tok[0];
-                    // Obtener/crear no terminal auxiliar que genera t
+                if (productions_[i].IsTerminal(k)) {
+                    char t = productions_[i].rhs[k][0];
+                    // Obtener/crear no terminal auxiliar que genera t (puede
+                    // añadir a productions_, así que no se guardan referencias)
                     std::string nt = TerminalToNonTerminal(t);
                     // Reemplazar el token terminal por el nombre del no terminal creado
-                    tok = nt;
+                    productions_[i].rhs[k] = nt;
                 }
             }
+            productions_[i].quoted.clear(); // ya no quedan terminales en la RHS
         }
     }
 
     // Segundo loop: para producciones con m >= 3, descomponer en producciones binarias
     vector<Production> new_productions; // nuevas producciones resultantes
-    for (const auto& p : productions_) {
-        if (p.rhs.size() >= 3) {
-            // m = longitud de RHS
-            size_t m = p.rhs.size();
-
-            // primera producción: A -> B1 D1
-            Production first;
-            first.lhs = p.lhs;
-            first.rhs.clear();
-            first.rhs.push_back(p.rhs[0]); // B1
-            std::string prevD = NewD(); // D1
-            first.rhs.push_back(prevD); // A -> B1 D1
-            new_productions.push_back(first);
-
-           // Crear producciones intermedias D_i -> B_{i+1} D_{i+1}
-            for (size_t i = 1; i < m - 2; ++i) {
-                Production mid;
-                mid.lhs = prevD; // D_i
-                mid.rhs.clear();
-                mid.rhs.push_back(p.rhs[i]); // B_{i+1}
-                std::string nextD = NewD(); // D_{i+1}
-                mid.rhs.push_back(nextD);
-                new_productions.push_back(mid);
-                prevD = nextD; // avanzar el puntero de D
+    ProductionKeySet seen;              // con clases de terminales, reglas ya binarizadas
+    for (size_t index = 0; index < productions_.size(); ++index) {
+        // Las reglas que solo difieren en terminales equivalentes son ya iguales;
+        // se binarizan una sola vez para no crear Dk repetidos
+        if (group_terminals_ && !seen.insert(ProductionKey(productions_[index])).second) continue;
+        BinarizeProduction(
+            productions_[index], [&]() { return NewD(); },
+            [&](const std::string& d, size_t position) { aux_origin_[d] = std::make_pair(index, position); },
+            new_productions);
+    }
+
+    // Reemplazar el conjunto de producciones por las nuevas (binarizadas)
+    productions_.swap(new_productions);
+    // Eliminar las producciones que hayan quedado repetidas
+    RemoveDuplicateProductions();
+}
+
+/**
+ * @brief Aplica el Algoritmo 1 repartiendo las producciones entre hilos.
+ *
+ * Fase 1 (paralela): cada fragmento anota sus terminales en orden de primera
+ * aparición (en producciones con m >= 2) y cuántos Dk necesita.
+ * Mezcla (secuencial): se crean los Ca recorriendo los fragmentos en orden y
+ * se reserva a cada fragmento un bloque consecutivo de números Dk.
+ * Fase 2 (paralela): cada fragmento sustituye terminales y binariza con su
+ * bloque de Dk. Al concatenar en orden se obtiene la misma salida que la
+ * versión secuencial.
+ */
+void Grammar::TransformToCNFParallel(unsigned threads) {
+    // Por debajo de este número de producciones no compensa crear hilos
+    const size_t kMinParallelProductions = 4096;
+    const size_t n = productions_.size();
+    if (threads <= 1 || n < kMinParallelProductions || group_terminals_) {
+        TransformToCNF();
+        return;
+    }
+
+    source_productions_ = productions_;
+    aux_origin_.clear();
+
+
+    // Varios fragmentos por hilo para repartir mejor la carga
+    const size_t shards = std::min(n, static_cast<size_t>(threads) * 4);
+    const size_t per_shard = (n + shards - 1) / shards;
+    struct Shard {
+        vector<char> first_terminals; // terminales en orden de primera aparición
+        int num_d = 0;                // número de Dk necesarios
+        int base_d = 0;               // último número Dk usado antes del fragmento
+        vector<Production> out;       // producciones resultantes
+        vector<std::tuple<string, size_t, size_t>> origins; // (Dk, producción, posición)
+    };
+    vector<Shard> shard(shards);
+
+    // Fase 1: terminales usados y número de Dk por fragmento
+    ParallelFor(0, shards, threads, [&](size_t s) {
+        std::array<bool, 256> seen{};
+        size_t hi = std::min(n, (s + 1) * per_shard);
+        for (size_t i = s * per_shard; i < hi; ++i) {
+            const Production& p = productions_[i];
+            if (p.rhs.size() < 2) continue;
+            for (size_t k = 0; k < p.rhs.size(); ++k) {
+                unsigned char c = static_cast<unsigned char>(p.rhs[k][0]);
+                if (p.IsTerminal(k) && !seen[c]) {
+                    seen[c] = true;
+                    shard[s].first_terminals.push_back(p.rhs[k][0]);
+                }
+            }
+            if (p.rhs.size() >= 3) shard[s].num_d += static_cast<int>(p.rhs.size()) - 2;
+        }
+    });
+
+    // Mezcla: Ca en el orden global de primera aparición y bloques de Dk
+    int next_d = counter_d_;
+    for (auto& sh : shard) {
+        for (char t : sh.first_terminals) TerminalToNonTerminal(t);
+        sh.base_d = next_d;
+        next_d += sh.num_d;
+    }
+
+    // Fase 2: sustituir terminales (solo lectura de terminal_to_nt_) y binarizar
+    ParallelFor(0, shards, threads, [&](size_t s) {
+        Shard& sh = shard[s];
+        int d = sh.base_d;
+        size_t hi = std::min(n, (s + 1) * per_shard);
+        for (size_t i = s * per_shard; i < hi; ++i) {
+            Production p = productions_[i];
+            if (p.rhs.size() >= 2) {
+                for (size_t k = 0; k < p.rhs.size(); ++k) {
+                    if (p.IsTerminal(k)) p.rhs[k] = terminal_to_nt_.at(p.rhs[k][0]);
+                }
+                p.quoted.clear();
             }
+            BinarizeProduction(
+                p, [&]() { return string("D") + std::to_string(++d); },
+                [&](const string& name, size_t position) { sh.origins.emplace_back(name, i, position); },
+                sh.out);
+        }
+    });
 
-            // Última producción: D_{m-2} -> B_{m-1} B_m
-            Production last;
-            last.lhs = prevD; // D_{m-2}
-            last.rhs.clear();
-            last.rhs.push_back(p.rhs[m - 2]); // B_{m-1}
-            last.rhs.push_back(p.rhs[m - 1]); // B_m
-            new_productions.push_back(last);
-        } else {
-            // Producción con m < 3, se mantiene igual
-            new_productions.push_back(p);
+    // Concatenar en orden los fragmentos y, al final, las producciones Ca -> a
+    vector<Production> new_productions;
+    size_t total = productions_.size() - n;
+    for (const auto& sh : shard) total += sh.out.size();
+    new_productions.reserve(total);
+    for (auto& sh : shard) {
+        for (auto& p : sh.out) new_productions.push_back(std::move(p));
+        for (const auto& [name, index, position] : sh.origins) {
+            nonterminals_.insert(name);
+            aux_origin_[name] = std::make_pair(index, position);
         }
     }
+    for (size_t i = n; i < productions_.size(); ++i) new_productions.push_back(productions_[i]);
+    counter_d_ = next_d;
 
-    // Reemplazar el conjunto de producciones por las nuevas (binarizadas)
     productions_.swap(new_productions);
+    RemoveDuplicateProductions();
+}
+
+/**
+ * @brief Aplica el Algoritmo 1 a una sola producción.
+ *
+ * Sustituye los terminales por Ca si m >= 2 (creando los Ca que falten, cuyas
+ * producciones Ca -> a se acumulan en productions_) y binariza con nuevos Dk.
+ * Los Dk no se guardan en nonterminals_; solo avanza counter_d_.
+ */
+void Grammar::ConvertProduction(Production& p, vector<Production>& rules) {
+    if (p.rhs.size() >= 2) {
+        for (size_t k = 0; k < p.rhs.size(); ++k) {
+            if (p.IsTerminal(k)) p.rhs[k] = TerminalToNonTerminal(p.rhs[k][0]);
+        }
+        p.quoted.clear();
+    }
+    BinarizeProduction(
+        p, [&]() { return string("D") + std::to_string(++counter_d_); },
+        [](const string&, size_t) {}, rules);
+}
+
+/**
+ * @brief Escribe el fichero final: cabecera, reglas del fichero temporal y
+ *        producciones Ca -> a.
+ *
+ * Los no terminales se escriben mezclando el conjunto (entrada y Ca) con
+ * D1..Dn en orden lexicográfico; los números 1..n se recorren en ese orden
+ * sin guardarlos, así que el resultado coincide con WriteToFile().
+ */
+void Grammar::WriteAssembled(const string& output, const string& spool_path, size_t written) const {
+    std::ofstream ofs(output);
+    if (!ofs) throw std::runtime_error("No se pudo crear el fichero de salida: " + output);
+    ofs << terminals_.size() << "\n";
+    for (char t : terminals_) ofs << t << "\n";
+
+    ofs << nonterminals_.size() + static_cast<size_t>(counter_d_) << "\n";
+    auto named = nonterminals_.begin();
+    long d = counter_d_ > 0 ? 1 : 0;
+    for (int k = 0; k < counter_d_; ++k) {
+        string dname = "D" + std::to_string(d);
+        while (named != nonterminals_.end() && *named < dname) ofs << *named++ << "\n";
+        ofs << dname << "\n";
+        // Siguiente número en orden lexicográfico
+        if (d * 10 <= counter_d_) {
+            d *= 10;
+        } else {
+            while (d % 10 == 9 || d + 1 > counter_d_) d /= 10;
+            ++d;
+        }
+    }
+    while (named != nonterminals_.end()) ofs << *named++ << "\n";
+
+    ofs << written + productions_.size() << "\n";
+    std::ifstream spool_in(spool_path);
+    if (written > 0) ofs << spool_in.rdbuf();
+    for (const auto& p : productions_) WriteProduction(ofs, p);
+    if (!ofs) throw std::runtime_error("Error al escribir el fichero de salida: " + output);
+}
+
+/**
+ * @brief Las clases de terminales dependen de todas las producciones, así
+ *        que no se pueden calcular al convertir regla a regla.
+ * @throws std::runtime_error Si la agrupación de terminales está activada.
+ */
+void Grammar::RejectTerminalGrouping(const char* method) const {
+    if (group_terminals_) {
+        throw std::runtime_error(string(method) + ": la agrupación de terminales necesita todas las "
+                                 "producciones y no se puede usar al convertir por flujo.");
+    }
+}
+
+/**
+ * @brief Convierte a FNC leyendo y escribiendo producción a producción.
+ *
+ * Cada producción se valida y se transforma al leerla (el Algoritmo 1 es
+ * local a cada regla) y sus reglas se escriben en un fichero temporal
+ * output + ".spool". En memoria solo quedan los símbolos de la entrada, los
+ * Ca y sus producciones Ca -> a. A diferencia de ReadFromFile(), las
+ * producciones repetidas en la entrada no se descartan.
+ */
+size_t Grammar::ConvertStreaming(const string& input, const string& output) {
+    RejectTerminalGrouping("ConvertStreaming");
+    std::ifstream ifs(input);
+    if (!ifs) {
+        throw std::runtime_error("No se pudo abrir el fichero de entrada: " + input);
+    }
+    int pcount = ReadHeader(ifs);
+    SymbolClasses classes = ClassifySymbols(terminals_, nonterminals_);
+
+    const string spool_path = output + ".spool";
+    size_t written = 0;
+    try {
+        std::ofstream spool(spool_path);
+        if (!spool) throw std::runtime_error("No se pudo crear el fichero temporal: " + spool_path);
+
+        vector<Production> rules; // reglas en FNC de la producción actual
+        for (int i = 0; i < pcount; ++i) {
+            Production p = ReadProductionLine(ifs);
+            string err = ProductionFormatError(p, classes);
+            if (err.empty()) err = PreconditionError(p);
+            if (!err.empty()) throw std::runtime_error(err);
+
+            rules.clear();
+            ConvertProduction(p, rules);
+            for (const auto& r : rules) WriteProduction(spool, r);
+            written += rules.size();
+        }
+        spool.close();
+        if (!spool) throw std::runtime_error("Error al escribir el fichero temporal: " + spool_path);
+        WriteAssembled(output, spool_path, written);
+    } catch (...) {
+        std::remove(spool_path.c_str());
+        throw;
+    }
+    std::remove(spool_path.c_str());
+    return written + productions_.size();
+}
+
+/**
+ * @brief Convierte a FNC con tres hilos: lectura, conversión y escritura.
+ *
+ * Etapa 1: lee, descarta repetidas y valida las producciones.
+ * Etapa 2: aplica el Algoritmo 1 a cada producción.
+ * Etapa 3 (hilo llamante): formatea las reglas y las escribe en el fichero
+ * temporal. Las etapas se pasan lotes de producciones por colas SPSC
+ * acotadas; un lote vacío marca el final. Si una etapa falla activa la señal
+ * de parada, las demás terminan y se relanza su excepción.
+ */
+size_t Grammar::ConvertPipelined(const string& input, const string& output) {
+    RejectTerminalGrouping("ConvertPipelined");
+    std::ifstream ifs(input);
+    if (!ifs) {
+        throw std::runtime_error("No se pudo abrir el fichero de entrada: " + input);
+    }
+    int pcount = ReadHeader(ifs);
+    SymbolClasses classes = ClassifySymbols(terminals_, nonterminals_);
+
+    using Batch = vector<Production>;
+    const size_t kBatchSize = 1024;  // producciones por lote
+    const size_t kQueueBatches = 64; // lotes en vuelo por cola
+    SpscQueue<Batch> parsed(kQueueBatches);
+    SpscQueue<Batch> converted(kQueueBatches);
+    std::atomic<bool> stop(false);
+    std::exception_ptr read_error, convert_error;
+
+    // Etapa 1: lectura, deduplicación y validación. Hasta el join solo usa
+    // classes, la cabecera leída y los ids internados, que la conversión no toca
+    std::thread reader([&]() {
+        try {
+            ProductionKeySet seen;
+            Batch batch;
+            for (int i = 0; i < pcount; ++i) {
+                Production p = ReadProductionLine(ifs);
+                if (!seen.insert(ProductionKey(p)).second) continue;
+                string err = ProductionFormatError(p, classes);
+                if (err.empty()) err = PreconditionError(p);
+                if (!err.empty()) throw std::runtime_error(err);
+                batch.push_back(std::move(p));
+                if (batch.size() == kBatchSize) {
+                    if (!parsed.Push(std::move(batch), stop)) return;
+                    batch.clear(); // un vector movido queda en un estado válido pero no especificado
+                }
+            }
+            if (!batch.empty() && !parsed.Push(std::move(batch), stop)) return;
+            parsed.Push(Batch(), stop);
+        } catch (...) {
+            read_error = std::current_exception();
+            stop = true;
+        }
+    });
+
+    // Etapa 2: conversión
+    std::thread converter([&]() {
+        try {
+            Batch in;
+            while (parsed.Pop(in, stop) && !in.empty()) {
+                Batch out;
+                for (auto& p : in) ConvertProduction(p, out);
+                if (!converted.Push(std::move(out), stop)) return;
+            }
+            converted.Push(Batch(), stop);
+        } catch (...) {
+            convert_error = std::current_exception();
+            stop = true;
+        }
+    });
+
+    // Etapa 3: formateo y escritura en el fichero temporal
+    const string spool_path = output + ".spool";
+    size_t written = 0;
+    try {
+        std::ofstream spool(spool_path);
+        if (!spool) throw std::runtime_error("No se pudo crear el fichero temporal: " + spool_path);
+        Batch rules;
+        while (converted.Pop(rules, stop) && !rules.empty()) {
+            for (const auto& r : rules) WriteProduction(spool, r);
+            written += rules.size();
+        }
+        spool.close();
+        if (!spool) throw std::runtime_error("Error al escribir el fichero temporal: " + spool_path);
+    } catch (...) {
+        stop = true;
+        reader.join();
+        converter.join();
+        std::remove(spool_path.c_str());
+        throw;
+    }
+    reader.join();
+    converter.join();
+
+    try {
+        if (read_error) std::rethrow_exception(read_error);
+        if (convert_error) std::rethrow_exception(convert_error);
+        WriteAssembled(output, spool_path, written);
+    } catch (...) {
+        std::remove(spool_path.c_str());
+        throw;
+    }
+    std::remove(spool_path.c_str());
+    return written + productions_.size();
+}
+
+/**
+ * @brief Clases de equivalencia de terminales por contextos exactos.
+ *
+ * El contexto de una aparición de t en A -> X1..Xm (posición i) es la
+ * producción con un hueco en i. Se internan los contextos y cada terminal
+ * queda descrito por la lista ordenada de ids de sus contextos; los
+ * terminales con la misma lista forman una clase. Como los contextos son
+ * exactos, cambiar un terminal por otro de su clase en cualquier posición
+ * de cualquier regla produce otra regla de la gramática, así que el
+ * lenguaje no cambia al agrupar. Coste O(sum m^2) por la copia de contextos.
+ */
+int Grammar::TerminalClasses(std::array<int, 256>& class_of) const {
+    class_of.fill(-1);
+    std::unordered_map<string, int> ids;   // símbolo -> id local
+    auto id_of = [&](const string& sym) {
+        return ids.emplace(sym, static_cast<int>(ids.size())).first->second;
+    };
+    std::unordered_map<vector<int>, int, ProductionKeyHash> context_ids;
+    std::array<vector<int>, 256> signature;                // byte -> ids de contextos
+
+    for (const auto& p : productions_) {
+        if (p.IsEmpty()) continue;
+        vector<int> key;
+        key.reserve(p.rhs.size() + 1);
+        key.push_back(id_of(p.lhs));
+        for (const auto& tok : p.rhs) key.push_back(id_of(tok));
+        for (size_t i = 0; i < p.rhs.size(); ++i) {
+            const string& tok = p.rhs[i];
+            if (!p.IsTerminal(i)) continue;
+            int saved = key[i + 1];
+            key[i + 1] = -1; // hueco
+            int ctx = context_ids.emplace(key, static_cast<int>(context_ids.size())).first->second;
+            key[i + 1] = saved;
+            signature[static_cast<unsigned char>(tok[0])].push_back(ctx);
+        }
+    }
+
+    // Agrupar por firma, numerando las clases en el orden de los terminales
+    std::map<vector<int>, int> class_ids;
+    for (char t : terminals_) {
+        vector<int>& sig = signature[static_cast<unsigned char>(t)];
+        std::sort(sig.begin(), sig.end());
+        sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+        class_of[static_cast<unsigned char>(t)] =
+            class_ids.emplace(sig, static_cast<int>(class_ids.size())).first->second;
+    }
+    return static_cast<int>(class_ids.size());
+}
+
+/**
+ * @brief Activa o desactiva el agrupamiento de terminales en TransformToCNF().
+ */
+void Grammar::SetTerminalGrouping(bool enabled) {
+    group_terminals_ = enabled;
+}
+
+/**
+ * @brief Asigna (o recupera) el id interno de un símbolo.
+ * @param s Símbolo (terminal o no terminal).
+ * @return id del símbolo.
+ */
+int Grammar::InternSymbol(const std::string& s) {
+    auto it = symbol_ids_.find(s);
+    if (it != symbol_ids_.end()) return it->second;
+    int id = static_cast<int>(symbol_ids_.size());
+    symbol_ids_.emplace(s, id);
+    symbol_names_.push_back(s);
+    return id;
+}
+
+/**
+ * @brief Construye la clave de una producción: id de la LHS seguido de los de la RHS
+ *        (con bits invertidos si el token es un terminal entre comillas).
+ * @param p Producción.
+ * @return vector de ids internados.
+ */
+std::vector<int> Grammar::ProductionKey(const Production& p) {
+    vector<int> key;
+    key.reserve(p.rhs.size() + 1);
+    key.push_back(InternSymbol(p.lhs));
+    for (size_t k = 0; k < p.rhs.size(); ++k) {
+        // un terminal entre comillas no coincide con el token sin comillas
+        int id = InternSymbol(p.rhs[k]);
+        key.push_back(p.IsQuoted(k) ? ~id : id);
+    }
+    return key;
+}
+
+/**
+ * @brief Elimina producciones repetidas en una pasada con un conjunto hash.
+ */
+void Grammar::RemoveDuplicateProductions() {
+    ProductionKeySet seen;
+    vector<Production> unique;
+    unique.reserve(productions_.size());
+    for (auto& p : productions_) {
+        if (seen.insert(ProductionKey(p)).second) unique.push_back(std::move(p));
+    }
+    productions_.swap(unique);
 }
 
 /**
@@ -430,58 +1147,623 @@ std::string Grammar::StartSymbol() const {
     return start_symbol_;
 }
 
-// MODIF:
 /**
- * @brief Devuelve el conjunto de no terminales declarados en la gramática de entrada.
+ * @brief Devuelve las producciones actuales de la gramática.
+ * @return vector de producciones.
  */
-std::set<char> Grammar::DeclaredNonTerminals() const {
-    std::set<char> out;
-    for (const auto& nt : nonterminals_) {
-        if (nt.size() == 1 && std::isupper(static_cast<unsigned char>(nt[0]))) {
-            out.insert(nt[0]);
-        }
+const std::vector<Production>& Grammar::Productions() const {
+    return productions_;
+}
+
+/**
+ * @brief Devuelve el conjunto de terminales.
+ * @return conjunto de terminales.
+ */
+const std::set<char>& Grammar::Terminals() const {
+    return terminals_;
+}
+
+/**
+ * @brief Devuelve el conjunto de no terminales.
+ * @return conjunto de no terminales.
+ */
+const std::set<std::string>& Grammar::NonTerminals() const {
+    return nonterminals_;
+}
+
+/**
+ * @brief Devuelve las producciones previas a la conversión.
+ * @return vector de producciones originales.
+ */
+const std::vector<Production>& Grammar::SourceProductions() const {
+    return source_productions_;
+}
+
+/**
+ * @brief Busca el origen de un no terminal auxiliar Dk.
+ * @return true si nt fue creado al binarizar una producción.
+ */
+bool Grammar::AuxiliaryOrigin(const std::string& nt, size_t& production, size_t& position) const {
+    auto it = aux_origin_.find(nt);
+    if (it == aux_origin_.end()) return false;
+    production = it->second.first;
+    position = it->second.second;
+    return true;
+}
+
+/**
+ * @brief Busca el terminal representado por un no terminal auxiliar Ca.
+ * @return true si nt fue creado para sustituir un terminal.
+ */
+bool Grammar::TerminalOf(const std::string& nt, char& t) const {
+    for (const auto& [term, name] : terminal_to_nt_) {
+        if (name == nt) { t = term; return true; }
     }
+    return false;
+}
+
+const std::map<char, std::string>& Grammar::TerminalNonTerminals() const { return terminal_to_nt_; }
+
+// MODIF:
+/**
+ * @brief Devuelve los ids de los no terminales declarados en la gramática de entrada.
+ */
+std::set<int> Grammar::DeclaredNonTerminals() const {
+    std::set<int> out;
+    for (int id = 0; id < num_input_nonterminals_; ++id) out.insert(id);
     return out;
 }
 
 /**
- * @brief Devuelve el conjunto de no terminales alcanzables desde el símbolo inicial.
+ * @brief Devuelve los ids de los no terminales alcanzables desde el símbolo inicial.
+ *
+ * Recorrido en anchura sobre un índice de producciones por LHS, de modo que
+ * cada producción se examina una sola vez.
  */
-std::set<char> Grammar::ReachableNonTerminals() const {
-    std::set<char> reachable;
+std::set<int> Grammar::ReachableNonTerminals() const {
+    std::set<int> reachable;
 
     // Si no hay símbolo inicial definido, devolver conjunto vacío
-    if (start_symbol_.empty()) return reachable;
+    auto start = symbol_ids_.find(start_symbol_);
+    if (start == symbol_ids_.end()) return reachable;
 
-    // El símbolo inicial, en la entrada, es una única letra mayúscula
-    char s = start_symbol_[0];
-    if (!std::isupper(static_cast<unsigned char>(s))) return reachable;
+    // Producciones agrupadas por el id de su LHS
+    vector<vector<size_t>> by_lhs(symbol_names_.size());
+    for (size_t i = 0; i < productions_.size(); ++i) {
+        auto it = symbol_ids_.find(productions_[i].lhs);
+        if (it != symbol_ids_.end()) by_lhs[it->second].push_back(i);
+    }
 
-    std::queue<char> q;
-    reachable.insert(s);
-    q.push(s);
+    std::queue<int> q;
+    reachable.insert(start->second);
+    q.push(start->second);
 
     // iterar mientras haya no terminales por explorar
     while (!q.empty()) {
-        char A = q.front();
+        int a = q.front();
         q.pop();
-        // LHS esperado como string de longitud 1
-        std::string lhs(1, A);
-        // Recorrer todas las producciones y buscar las de LHS == A
-        for (const auto& p : productions_) {
-            if (p.lhs != lhs) continue;
-            // Examinar tokens de RHS, si son no terminales de 1 carácter se consideran
-            for (const auto& tok : p.rhs) {
-                if (tok.size() == 1 && std::isupper(static_cast<unsigned char>(tok[0]))) {
-                    char B = tok[0];
-                    // Si no estaba visitado
-                    if (reachable.insert(B).second) {
-                        q.push(B);
+        for (size_t i : by_lhs[a]) {
+            // Examinar tokens de RHS; los no terminales empiezan por mayúscula
+            const Production& p = productions_[i];
+            for (size_t k = 0; k < p.rhs.size(); ++k) {
+                const string& tok = p.rhs[k];
+                if (p.IsQuoted(k) || !std::isupper(static_cast<unsigned char>(tok[0]))) continue;
+                auto it = symbol_ids_.find(tok);
+                // Si no estaba visitado
+                if (it != symbol_ids_.end() && reachable.insert(it->second).second) q.push(it->second);
+            }
+        }
+    }
+
+    return reachable;
+}
+
+/**
+ * @brief Nombre del símbolo con el id dado.
+ */
+const std::string& Grammar::SymbolName(int id) const {
+    return symbol_names_.at(static_cast<size_t>(id));
+}
+
+/**
+ * @brief Componentes con Tarjan sobre el grafo A -> B (B en una regla de A).
+ *
+ * StronglyConnectedComponents() ya numera en orden topológico inverso del
+ * grafo, que es el orden "dependencias primero" de ComponentGraph.
+ */
+ComponentGraph Grammar::Components() const {
+    ComponentGraph graph;
+    graph.nonterminals.assign(nonterminals_.begin(), nonterminals_.end());
+    const size_t n = graph.nonterminals.size();
+    std::unordered_map<string, int> nt_id;
+    for (size_t i = 0; i < n; ++i) nt_id[graph.nonterminals[i]] = static_cast<int>(i);
+
+    vector<vector<int>> adj(n);
+    for (const auto& p : productions_) {
+        for (const auto& tok : p.rhs) {
+            auto it = nt_id.find(tok);
+            if (it != nt_id.end()) adj[nt_id.at(p.lhs)].push_back(it->second);
+        }
+    }
+    const int count = StronglyConnectedComponents(adj, graph.component);
+
+    graph.members.resize(count);
+    graph.uses.resize(count);
+    graph.productions.resize(count);
+    graph.recursive.assign(count, false);
+    for (size_t a = 0; a < n; ++a) graph.members[graph.component[a]].push_back(static_cast<int>(a));
+    for (size_t a = 0; a < n; ++a) {
+        const int c = graph.component[a];
+        if (graph.members[c].size() > 1) graph.recursive[c] = true;
+        for (int b : adj[a]) {
+            if (graph.component[b] != c) graph.uses[c].push_back(graph.component[b]);
+            else graph.recursive[c] = true; // A -> ... B ... con B en la misma componente (o A)
+        }
+    }
+    for (auto& u : graph.uses) {
+        std::sort(u.begin(), u.end());
+        u.erase(std::unique(u.begin(), u.end()), u.end());
+    }
+    for (size_t i = 0; i < productions_.size(); ++i) {
+        graph.productions[graph.component[nt_id.at(productions_[i].lhs)]].push_back(i);
+    }
+    return graph;
+}
+
+/**
+ * @brief Punto fijo ascendente por componentes: un no terminal cumple la
+ *        propiedad si alguna de sus reglas solo tiene símbolos que la cumplen.
+ *
+ * Si nullable es true los terminales no la cumplen (anulables); si no, la
+ * cumplen todos (generadores). Dentro de cada componente cada regla lleva la
+ * cuenta de las apariciones de miembros de la componente que aún no se sabe
+ * que la cumplan; los no terminales de las componentes que usa ya están
+ * decididos. Cada aparición se visita una sola vez, por lo que el coste es
+ * O(|G|). Cada componente solo escribe en sus miembros, así que las
+ * independientes se resuelven en paralelo.
+ *
+ * @return holds[id] para cada no terminal de graph.
+ */
+static vector<char> ComponentFixpoint(const ComponentGraph& graph, const vector<Production>& productions,
+                                      bool nullable, unsigned threads) {
+    const size_t n = graph.nonterminals.size();
+    std::unordered_map<string, int> nt_id;
+    for (size_t i = 0; i < n; ++i) nt_id[graph.nonterminals[i]] = static_cast<int>(i);
+    vector<int> local(n); // posición de cada no terminal dentro de su componente
+    for (const auto& m : graph.members) {
+        for (size_t k = 0; k < m.size(); ++k) local[m[k]] = static_cast<int>(k);
+    }
+
+    vector<char> holds(n, 0);
+    ParallelDag(graph.uses, threads, [&](int c) {
+        const vector<size_t>& rules = graph.productions[c];
+        vector<vector<size_t>> occurrences(graph.members[c].size());
+        vector<size_t> pending(rules.size(), 0);
+        vector<int> stack;
+        for (size_t r = 0; r < rules.size(); ++r) {
+            const Production& p = productions[rules[r]];
+            bool dead = false;
+            if (!p.IsEmpty()) {
+                for (const auto& tok : p.rhs) {
+                    auto it = nt_id.find(tok);
+                    if (it == nt_id.end()) {
+                        dead = dead || nullable;
+                    } else if (graph.component[it->second] != c) {
+                        dead = dead || !holds[it->second];
+                    } else {
+                        occurrences[local[it->second]].push_back(r);
+                        ++pending[r];
                     }
                 }
             }
+            if (dead) pending[r] = p.rhs.size() + 1; // nunca llega a 0
+            int a = nt_id.at(p.lhs);
+            if (pending[r] == 0 && !holds[a]) {
+                holds[a] = 1;
+                stack.push_back(a);
+            }
         }
+        while (!stack.empty()) {
+            int b = stack.back();
+            stack.pop_back();
+            for (size_t r : occurrences[local[b]]) {
+                int a = nt_id.at(productions[rules[r]].lhs);
+                if (--pending[r] == 0 && !holds[a]) {
+                    holds[a] = 1;
+                    stack.push_back(a);
+                }
+            }
+        }
+    });
+    return holds;
+}
+
+/**
+ * @brief No terminales generadores: ComponentFixpoint() con los terminales
+ *        (y &) como símbolos que cumplen la propiedad.
+ */
+std::set<std::string> Grammar::GeneratingNonTerminals(unsigned threads) const {
+    ComponentGraph graph = Components();
+    vector<char> holds = ComponentFixpoint(graph, productions_, false, threads);
+    set<string> generating;
+    for (size_t a = 0; a < holds.size(); ++a) {
+        if (holds[a]) generating.insert(graph.nonterminals[a]);
     }
+    return generating;
+}
 
-    return reachable;
-}
\ No newline at end of file
+/**
+ * @brief No terminales anulables: solo cuentan las reglas A -> & y las que
+ *        no tienen terminales.
+ */
+std::set<std::string> Grammar::NullableNonTerminals(unsigned threads) const {
+    ComponentGraph graph = Components();
+    vector<char> holds = ComponentFixpoint(graph, productions_, true, threads);
+    set<string> nullable;
+    for (size_t a = 0; a < holds.size(); ++a) {
+        if (holds[a]) nullable.insert(graph.nonterminals[a]);
+    }
+    return nullable;
+}
+
+/**
+ * @brief El lenguaje es vacío si el símbolo de arranque no es generador.
+ */
+bool Grammar::IsEmpty() const {
+    return GeneratingNonTerminals().count(start_symbol_) == 0;
+}
+
+/**
+ * @brief Detecta un ciclo en el grafo de no terminales útiles con un DFS iterativo.
+ *
+ * Solo se consideran las producciones cuyos símbolos son todos generadores,
+ * y solo los no terminales alcanzables desde el arranque a través de ellas.
+ */
+bool Grammar::IsFinite(vector<string>* cycle) const {
+    set<string> generating = GeneratingNonTerminals();
+    if (generating.count(start_symbol_) == 0) return true; // lenguaje vacío
+
+    // Numerar no terminales generadores y construir las aristas A -> B
+    std::unordered_map<string, int> id;
+    vector<string> name;
+    for (const auto& nt : generating) {
+        id[nt] = static_cast<int>(name.size());
+        name.push_back(nt);
+    }
+    vector<vector<int>> edges(name.size());
+    for (const auto& p : productions_) {
+        auto lhs = id.find(p.lhs);
+        if (lhs == id.end()) continue;
+        bool useful = true;
+        for (const auto& tok : p.rhs) {
+            if (nonterminals_.count(tok) && !generating.count(tok)) { useful = false; break; }
+        }
+        if (!useful) continue;
+        for (const auto& tok : p.rhs) {
+            auto it = id.find(tok);
+            if (it != id.end()) edges[lhs->second].push_back(it->second);
+        }
+    }
+
+    // DFS desde el arranque: 0 = no visitado, 1 = en la pila, 2 = terminado
+    vector<int> color(name.size(), 0);
+    vector<int> parent(name.size(), -1);
+    vector<std::pair<int, size_t>> stack; // (nodo, siguiente arista)
+    int s = id[start_symbol_];
+    color[s] = 1;
+    stack.emplace_back(s, 0);
+    while (!stack.empty()) {
+        auto& [v, next] = stack.back();
+        if (next == edges[v].size()) {
+            color[v] = 2;
+            stack.pop_back();
+            continue;
+        }
+        int w = edges[v][next++];
+        if (color[w] == 0) {
+            color[w] = 1;
+            parent[w] = v;
+            stack.emplace_back(w, 0);
+        } else if (color[w] == 1) {
+            // Arista de retroceso v -> w: ciclo w -> ... -> v -> w
+            if (cycle) {
+                cycle->clear();
+                for (int u = v; u != w; u = parent[u]) cycle->push_back(name[u]);
+                cycle->push_back(name[w]);
+                std::reverse(cycle->begin(), cycle->end());
+                cycle->push_back(name[w]);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Prepara un TerminalSets vacío con los ids de la gramática.
+ */
+static TerminalSets EmptyTerminalSets(const set<string>& nonterminals, const set<char>& terminals) {
+    TerminalSets out;
+    out.nonterminals.assign(nonterminals.begin(), nonterminals.end());
+    out.terminals.assign(terminals.begin(), terminals.end());
+    out.words = (out.terminals.size() + 1 + 63) / 64;
+    out.bits.assign(out.nonterminals.size() * out.words, 0);
+    return out;
+}
+
+TerminalSets Grammar::FirstSets() const {
+    TerminalSets first = EmptyTerminalSets(nonterminals_, terminals_);
+    std::unordered_map<string, int> nt_id;
+    for (size_t i = 0; i < first.nonterminals.size(); ++i) nt_id[first.nonterminals[i]] = static_cast<int>(i);
+    std::array<int, 256> t_id;
+    t_id.fill(-1);
+    for (size_t i = 0; i < first.terminals.size(); ++i) t_id[static_cast<unsigned char>(first.terminals[i])] = static_cast<int>(i);
+
+    vector<char> nullable = ComponentFixpoint(Components(), productions_, true, 1);
+    const size_t eps = first.Special();
+    const size_t w = first.words;
+
+    // Terminales directos y aristas A -> B (A -> alfa B beta con alfa anulable)
+    vector<vector<int>> adj(first.nonterminals.size());
+    for (const auto& p : productions_) {
+        int a = nt_id.at(p.lhs);
+        if (p.IsEmpty()) continue;
+        for (const auto& tok : p.rhs) {
+            auto it = nt_id.find(tok);
+            if (it == nt_id.end()) {
+                int t = t_id[static_cast<unsigned char>(tok[0])];
+                if (t >= 0) first.bits[a * w + t / 64] |= uint64_t(1) << (t % 64);
+                break;
+            }
+            adj[a].push_back(it->second);
+            if (!nullable[it->second]) break;
+        }
+    }
+    SolveSetEquations(adj, w, first.bits);
+
+    // El especial indica anulabilidad, que no se hereda por las aristas
+    for (size_t a = 0; a < first.nonterminals.size(); ++a) {
+        uint64_t& word = first.bits[a * w + eps / 64];
+        word &= ~(uint64_t(1) << (eps % 64));
+        if (nullable[a]) word |= uint64_t(1) << (eps % 64);
+    }
+    return first;
+}
+
+TerminalSets Grammar::FollowSets() const {
+    TerminalSets first = FirstSets();
+    TerminalSets follow = EmptyTerminalSets(nonterminals_, terminals_);
+    std::unordered_map<string, int> nt_id;
+    for (size_t i = 0; i < follow.nonterminals.size(); ++i) nt_id[follow.nonterminals[i]] = static_cast<int>(i);
+    std::array<int, 256> t_id;
+    t_id.fill(-1);
+    for (size_t i = 0; i < follow.terminals.size(); ++i) t_id[static_cast<unsigned char>(follow.terminals[i])] = static_cast<int>(i);
+    const size_t w = follow.words;
+    const size_t end = follow.Special();
+    const uint64_t eps_mask = uint64_t(1) << (end % 64);
+
+    auto start = nt_id.find(start_symbol_);
+    if (start != nt_id.end()) follow.bits[start->second * w + end / 64] |= eps_mask;
+
+    // Para A -> X1..Xm, recorrer de derecha a izquierda acumulando FIRST del sufijo
+    vector<vector<int>> adj(follow.nonterminals.size()); // B -> A: FOLLOW(B) hereda FOLLOW(A)
+    vector<uint64_t> suffix(w);
+    for (const auto& p : productions_) {
+        if (p.IsEmpty()) continue;
+        int a = nt_id.at(p.lhs);
+        std::fill(suffix.begin(), suffix.end(), 0);
+        bool suffix_nullable = true;
+        for (size_t i = p.rhs.size(); i-- > 0;) {
+            auto it = nt_id.find(p.rhs[i]);
+            if (it == nt_id.end()) {
+                std::fill(suffix.begin(), suffix.end(), 0);
+                int t = t_id[static_cast<unsigned char>(p.rhs[i][0])];
+                if (t >= 0) suffix[t / 64] |= uint64_t(1) << (t % 64);
+                suffix_nullable = false;
+                continue;
+            }
+            int b = it->second;
+            uint64_t* fb = &follow.bits[b * w];
+            for (size_t k = 0; k < w; ++k) fb[k] |= suffix[k];
+            if (suffix_nullable && b != a) adj[b].push_back(a);
+            // Sufijo nuevo: FIRST(B) ∪ (sufijo anterior si B es anulable), sin epsilon
+            const uint64_t* fst = &first.bits[b * w];
+            bool b_nullable = first.Has(b, first.Special());
+            if (!b_nullable) std::fill(suffix.begin(), suffix.end(), 0);
+            for (size_t k = 0; k < w; ++k) suffix[k] |= fst[k];
+            suffix[end / 64] &= ~eps_mask;
+            suffix_nullable = suffix_nullable && b_nullable;
+        }
+    }
+    SolveSetEquations(adj, w, follow.bits);
+    return follow;
+}
+
+/**
+ * @brief Una regla es lineal por la derecha si solo su último símbolo puede
+ *        ser no terminal, y por la izquierda si solo puede serlo el primero.
+ *        Un no terminal pierde cada forma si alguna de sus reglas no la
+ *        cumple o si la pierde algún no terminal de su parte derecha, así que
+ *        las pérdidas se propagan hacia atrás por el grafo de dependencias.
+ */
+vector<Linearity> Grammar::LinearNonTerminals() const {
+    vector<string> names(nonterminals_.begin(), nonterminals_.end());
+    std::unordered_map<string, int> nt_id;
+    for (size_t i = 0; i < names.size(); ++i) nt_id[names[i]] = static_cast<int>(i);
+
+    const size_t n = names.size();
+    vector<bool> right(n, true), left(n, true);
+    vector<vector<int>> users(n); // B -> {A | B aparece en una regla de A}
+    for (const auto& p : productions_) {
+        int a = nt_id.at(p.lhs);
+        for (size_t k = 0; k < p.rhs.size(); ++k) {
+            auto it = nt_id.find(p.rhs[k]);
+            if (it == nt_id.end()) continue;
+            users[it->second].push_back(a);
+            if (k + 1 != p.rhs.size()) right[a] = false;
+            if (k != 0) left[a] = false;
+        }
+    }
+
+    for (vector<bool>* form : {&right, &left}) {
+        vector<int> queue;
+        for (size_t a = 0; a < n; ++a) {
+            if (!(*form)[a]) queue.push_back(static_cast<int>(a));
+        }
+        while (!queue.empty()) {
+            int b = queue.back();
+            queue.pop_back();
+            for (int a : users[b]) {
+                if ((*form)[a]) {
+                    (*form)[a] = false;
+                    queue.push_back(a);
+                }
+            }
+        }
+    }
+
+    vector<Linearity> result(n, Linearity::kNone);
+    for (size_t a = 0; a < n; ++a) {
+        if (right[a]) result[a] = Linearity::kRight;
+        else if (left[a]) result[a] = Linearity::kLeft;
+    }
+    return result;
+}
+
+vector<Linearity> Grammar::RegularNonTerminals(vector<int>* component) const {
+    ComponentGraph graph = Components();
+    std::unordered_map<string, int> nt_id;
+    for (size_t i = 0; i < graph.nonterminals.size(); ++i) nt_id[graph.nonterminals[i]] = static_cast<int>(i);
+    const vector<int>& comp = graph.component;
+    const vector<vector<int>>& uses = graph.uses;
+    const int count = static_cast<int>(graph.Size());
+
+    // Forma de cada componente respecto a sus miembros
+    vector<bool> right(count, true), left(count, true);
+    for (const auto& p : productions_) {
+        const int c = comp[nt_id.at(p.lhs)];
+        for (size_t k = 0; k < p.rhs.size(); ++k) {
+            auto it = nt_id.find(p.rhs[k]);
+            if (it == nt_id.end() || comp[it->second] != c) continue;
+            if (k + 1 != p.rhs.size()) right[c] = false;
+            if (k != 0) left[c] = false;
+        }
+    }
+
+    // Las componentes usadas tienen un número menor, así que ya están decididas
+    vector<Linearity> form(count, Linearity::kNone);
+    for (int c = 0; c < count; ++c) {
+        if (!right[c] && !left[c]) continue;
+        bool lower_regular = true;
+        for (int d : uses[c]) lower_regular = lower_regular && form[d] != Linearity::kNone;
+        if (lower_regular) form[c] = right[c] ? Linearity::kRight : Linearity::kLeft;
+    }
+
+    vector<Linearity> result(comp.size());
+    for (size_t a = 0; a < comp.size(); ++a) result[a] = form[comp[a]];
+    if (component) *component = comp;
+    return result;
+}
+
+void Grammar::RemoveProductionsOf(const std::set<std::string>& nts) {
+    productions_.erase(std::remove_if(productions_.begin(), productions_.end(),
+                                      [&](const Production& p) { return nts.count(p.lhs) != 0; }),
+                       productions_.end());
+}
+
+/**
+ * @brief Refinamiento de particiones por firmas hash de las reglas.
+ *
+ * La partición final es la más gruesa que es estable: dos no terminales del
+ * mismo bloque tienen las mismas reglas salvo sustitución de cada no terminal
+ * por su bloque, por lo que generan el mismo lenguaje.
+ */
+MergeStats Grammar::MergeEquivalentNonTerminals() {
+    MergeStats stats;
+    vector<string> names(nonterminals_.begin(), nonterminals_.end());
+    std::unordered_map<string, int> id;
+    for (size_t i = 0; i < names.size(); ++i) id[names[i]] = static_cast<int>(i);
+
+    // Producciones agrupadas por LHS
+    vector<vector<size_t>> by_lhs(names.size());
+    for (size_t i = 0; i < productions_.size(); ++i) {
+        auto it = id.find(productions_[i].lhs);
+        if (it != id.end()) by_lhs[it->second].push_back(i);
+    }
+
+    vector<int> block(names.size(), 0);
+    size_t num_blocks = names.empty() ? 0 : 1;
+    for (;;) {
+        // Firma de cada no terminal: bloque actual + reglas con los no terminales
+        // sustituidos por su bloque (ordenadas y sin repetir)
+        std::unordered_map<string, int> next_id;
+        vector<int> next(names.size());
+        for (size_t a = 0; a < names.size(); ++a) {
+            vector<string> rules;
+            for (size_t pi : by_lhs[a]) {
+                string enc;
+                for (const auto& tok : productions_[pi].rhs) {
+                    auto it = id.find(tok);
+                    if (it != id.end()) enc += "#" + std::to_string(block[it->second]);
+                    else enc += "'" + tok;
+                    enc += '\x01';
+                }
+                rules.push_back(enc);
+            }
+            std::sort(rules.begin(), rules.end());
+            rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+            string sig = std::to_string(block[a]) + '\x02';
+            for (const auto& r : rules) sig += r + '\x02';
+            auto ins = next_id.emplace(sig, static_cast<int>(next_id.size()));
+            next[a] = ins.first->second;
+        }
+        block.swap(next);
+        // Los bloques solo se dividen: si no aumenta su número, la partición es estable
+        if (next_id.size() == num_blocks) break;
+        num_blocks = next_id.size();
+    }
+
+    // Elegir representante de cada bloque: arranque > no terminal de la entrada > auxiliar
+    auto rank = [&](const string& nt) {
+        if (nt == start_symbol_) return 0;
+        char t;
+        if (aux_origin_.count(nt) || TerminalOf(nt, t)) return 2;
+        return 1;
+    };
+    vector<int> rep(num_blocks, -1);
+    for (size_t a = 0; a < names.size(); ++a) {
+        int& r = rep[block[a]];
+        if (r < 0 || rank(names[a]) < rank(names[r])) r = static_cast<int>(a);
+    }
+    if (num_blocks == names.size()) return stats;
+
+    // Reescribir producciones: solo se conservan las de los representantes
+    size_t old_productions = productions_.size();
+    std::set<std::pair<string, vector<string>>> seen;
+    vector<Production> merged;
+    for (const auto& p : productions_) {
+        auto lhs = id.find(p.lhs);
+        if (lhs != id.end() && rep[block[lhs->second]] != lhs->second) continue;
+        Production q = p;
+        for (auto& tok : q.rhs) {
+            auto it = id.find(tok);
+            if (it != id.end()) tok = names[rep[block[it->second]]];
+        }
+        if (seen.insert(std::make_pair(q.lhs, q.rhs)).second) merged.push_back(q);
+    }
+    productions_.swap(merged);
+
+    // Eliminar los no terminales fusionados y sus datos auxiliares
+    for (size_t a = 0; a < names.size(); ++a) {
+        if (rep[block[a]] == static_cast<int>(a)) continue;
+        nonterminals_.erase(names[a]);
+        aux_origin_.erase(names[a]);
+        ++stats.nonterminals_removed;
+    }
+    for (auto it = terminal_to_nt_.begin(); it != terminal_to_nt_.end();) {
+        if (nonterminals_.count(it->second)) ++it;
+        else it = terminal_to_nt_.erase(it);
+    }
+    stats.productions_removed = old_productions - productions_.size();
+    return stats;
+}
@@ -38,10 +38,16 @@
 #ifndef GRAMMAR_H
 #define GRAMMAR_H
 
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <istream>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 /**
  * @brief Representa una producción de la gramática.
@@ -51,10 +57,101 @@
  *      comienzan por una letra mayúscula, los terminales son un solo carácter
  *      imprimible representado como cadena de longitud 1). La cadena vacía
  *      (epsilon) se representa con un único elemento "&".
+ * quoted: quoted[k] indica que rhs[k] es un terminal escrito entre comillas
+ *      que sin ellas se leería como otra cosa (una mayúscula o "&"). Solo se
+ *      marcan esos tokens; si no hay ninguno, el vector está vacío.
  */
 struct Production {
     std::string lhs; // Lado izquierdo de la producción
     std::vector<std::string> rhs; // Lado derecho de la producción
+    std::vector<bool> quoted; // Terminales entre comillas (paralelo a rhs, o vacío)
+
+    /**
+     * @brief Indica si rhs[k] está marcado como terminal entre comillas.
+     */
+    bool IsQuoted(size_t k) const { return k < quoted.size() && quoted[k]; }
+
+    /**
+     * @brief Indica si rhs[k] es un terminal: marcado entre comillas o un
+     *        único carácter que no es una mayúscula.
+     */
+    bool IsTerminal(size_t k) const {
+        return IsQuoted(k) || (rhs[k].size() == 1 && !std::isupper(static_cast<unsigned char>(rhs[k][0])));
+    }
+
+    /**
+     * @brief Indica si es la producción vacía (RHS "&" sin comillas).
+     */
+    bool IsEmpty() const { return rhs.size() == 1 && rhs[0] == "&" && !IsQuoted(0); }
+};
+
+/**
+ * @brief Indica si el terminal t debe ir entre comillas para no leerse como
+ *        un no terminal o como la cadena vacía.
+ */
+inline bool NeedsQuotes(char t) { return std::isupper(static_cast<unsigned char>(t)) || t == '&'; }
+
+/**
+ * @brief Forma de las reglas de la subgramática de un no terminal.
+ *
+ * kRight: A -> w o A -> w B; kLeft: A -> w o A -> B w (w cadena de
+ * terminales, posiblemente vacía). En ambos casos el lenguaje es regular.
+ */
+enum class Linearity { kNone, kRight, kLeft };
+
+/**
+ * @brief Resultado de la fusión de no terminales equivalentes.
+ */
+struct MergeStats {
+    size_t nonterminals_removed = 0; // no terminales eliminados
+    size_t productions_removed = 0;  // producciones eliminadas
+};
+
+/**
+ * @brief Grafo de componentes fuertemente conexas de la relación "A usa B"
+ *        (B aparece en alguna regla de A).
+ *
+ * Las componentes se numeran en orden topológico con las dependencias
+ * primero: si la componente c usa la d, entonces d < c. Los ids de no
+ * terminal siguen el orden de Grammar::NonTerminals().
+ */
+struct ComponentGraph {
+    std::vector<std::string> nonterminals;         // id -> no terminal
+    std::vector<int> component;                    // id -> componente
+    std::vector<std::vector<int>> members;         // componente -> ids de sus no terminales
+    std::vector<std::vector<int>> uses;            // componente -> componentes que usa (ordenadas, sin repetir)
+    std::vector<std::vector<size_t>> productions;  // componente -> índices de las reglas de sus miembros
+    std::vector<bool> recursive;                   // la componente contiene algún ciclo
+
+    /**
+     * @brief Número de componentes.
+     */
+    size_t Size() const { return members.size(); }
+};
+
+/**
+ * @brief Conjuntos de terminales por no terminal, como bits sobre ids de terminal.
+ *
+ * Es el resultado de Grammar::FirstSets() y Grammar::FollowSets(). Los ids de
+ * no terminal siguen el orden de Grammar::NonTerminals() y los de terminal el
+ * de Grammar::Terminals(); el id terminals.size() es un símbolo especial:
+ * epsilon en FIRST y el fin de cadena en FOLLOW.
+ */
+struct TerminalSets {
+    std::vector<std::string> nonterminals; // id -> no terminal
+    std::vector<char> terminals;           // id -> terminal
+    size_t words = 0;                      // palabras de 64 bits por conjunto
+    std::vector<uint64_t> bits;            // conjuntos consecutivos, uno por no terminal
+
+    /**
+     * @brief Id del símbolo especial (epsilon o fin de cadena).
+     */
+    size_t Special() const { return terminals.size(); }
+
+    /**
+     * @brief Indica si el conjunto del no terminal nt contiene el terminal (o especial) t.
+     */
+    bool Has(size_t nt, size_t t) const { return (bits[nt * words + t / 64] >> (t % 64)) & 1; }
 };
 
 /**
@@ -93,13 +190,19 @@ public:
      * @brief Valida que la gramática de entrada cumpla el convenio exigido por la práctica.
      *
      * Revisa que:
-     *  - todos los no terminales de la entrada sean una única letra mayúscula
+     *  - todos los no terminales de la entrada empiecen por una letra mayúscula
+     *    y no contengan espacios, '<', '>' ni comillas (ni usen los nombres
+     *    reservados Dk)
      *  - los terminales sean símbolos de un solo carácter
      *  - las producciones usen símbolos declarados
      *
+     * Si hay varios errores se informa del de la primera producción en orden
+     * de lectura, sea cual sea el número de hilos.
+     *
+     * @param threads Número de hilos para revisar las producciones.
      * @throws std::runtime_error Si detecta un error de formato.
      */
-    void ValidateFormat() const;
+    void ValidateFormat(unsigned threads = 1) const;
 
     /**
      * @brief Comprueba precondiciones requeridas por el Algoritmo 1.
@@ -120,6 +223,57 @@ public:
      */
     void TransformToCNF();
 
+    /**
+     * @brief Versión paralela de TransformToCNF() por fragmentos de producciones.
+     *
+     * Cada hilo recorre un fragmento de las producciones. Los Ca se crean al
+     * mezclar, en el orden global de primera aparición, y cada fragmento recibe
+     * un bloque reservado de números Dk, de modo que el resultado es idéntico
+     * al de TransformToCNF(). Con un solo hilo o pocas producciones se usa la
+     * versión secuencial, y también al agrupar terminales (ver
+     * SetTerminalGrouping()).
+     *
+     * @param threads Número de hilos.
+     */
+    void TransformToCNFParallel(unsigned threads);
+
+    /**
+     * @brief Convierte a FNC el fichero input y escribe el resultado en output
+     *        sin cargar todas las producciones en memoria.
+     *
+     * Cada producción se valida (formato y precondiciones) y se transforma
+     * mientras se lee; sus reglas se escriben en un fichero temporal que se
+     * concatena al final tras la cabecera. La memoria usada depende de la
+     * tabla de símbolos, no del número de producciones. El orden de la salida
+     * es el de TransformToCNF(), salvo que no se eliminan las producciones
+     * repetidas de la entrada. La gramática queda solo con la cabecera y las
+     * producciones Ca -> a.
+     *
+     * @param input Ruta del fichero .gra de entrada.
+     * @param output Ruta del fichero .gra de salida.
+     * @return número de producciones escritas.
+     * @throws std::runtime_error En caso de error de lectura, validación o
+     *         escritura, o si está activada la agrupación de terminales.
+     */
+    size_t ConvertStreaming(const std::string& input, const std::string& output);
+
+    /**
+     * @brief Convierte a FNC el fichero input solapando lectura, conversión y escritura.
+     *
+     * Tres hilos (lectura y validación, Algoritmo 1, formateo) se comunican
+     * por colas acotadas sin cerrojos de lotes de producciones. El fichero
+     * output es idéntico byte a byte al de ReadFromFile(), TransformToCNF() y
+     * WriteToFile(); solo cambia que los errores de formato y de
+     * precondiciones se informan en un único recorrido, por orden de línea.
+     *
+     * @param input Ruta del fichero .gra de entrada.
+     * @param output Ruta del fichero .gra de salida.
+     * @return número de producciones escritas.
+     * @throws std::runtime_error En caso de error de lectura, validación o
+     *         escritura, o si está activada la agrupación de terminales.
+     */
+    size_t ConvertPipelined(const std::string& input, const std::string& output);
+
     /**
      * @brief Devuelve el símbolo de arranque de la gramática.
      * @return cadena con el símbolo de arranque.
@@ -131,15 +285,225 @@ public:
      * @brief Devuelve el conjunto de no terminales alcanzables desde s.
      * Recorre todas las producciones partiendo de s y determina qué símbolos
      * no terminales pueden alcanzarse.
-     * @return Conjunto de símbolos no terminales alcanzables
+     * @return Ids (ver SymbolName()) de los no terminales alcanzables
      */
-    std::set<char> ReachableNonTerminals() const;
+    std::set<int> ReachableNonTerminals() const;
 
     /**
      * @brief Devuelve el conjunto de no terminales declarados en la entrada.
-     * @return Conjunto de no terminales declarados.
+     * @return Ids (ver SymbolName()) de los no terminales declarados.
+     */
+    std::set<int> DeclaredNonTerminals() const;
+
+    /**
+     * @brief Devuelve el nombre del símbolo con el id dado.
+     * @param id Id devuelto por ReachableNonTerminals() o DeclaredNonTerminals().
+     * @throws std::out_of_range Si el id no existe.
+     */
+    const std::string& SymbolName(int id) const;
+
+    /**
+     * @brief Devuelve las producciones actuales de la gramática.
+     * @return Referencia constante al vector de producciones.
+     */
+    const std::vector<Production>& Productions() const;
+
+    /**
+     * @brief Devuelve el conjunto de símbolos terminales.
+     * @return Referencia constante al conjunto de terminales.
+     */
+    const std::set<char>& Terminals() const;
+
+    /**
+     * @brief Devuelve el conjunto de símbolos no terminales (incluidos los auxiliares).
+     * @return Referencia constante al conjunto de no terminales.
+     */
+    const std::set<std::string>& NonTerminals() const;
+
+    /**
+     * @brief Devuelve las producciones tal como estaban antes de TransformToCNF().
+     * @return Vector de producciones originales (vacío si no se ha convertido).
+     */
+    const std::vector<Production>& SourceProductions() const;
+
+    /**
+     * @brief Indica de qué producción original procede un no terminal auxiliar Dk.
+     *
+     * Un Dk genera el sufijo rhs[position..] de la producción original
+     * SourceProductions()[production].
+     *
+     * @param nt Nombre del no terminal.
+     * @param production Índice de la producción original (salida).
+     * @param position Posición en la RHS donde empieza el sufijo (salida).
+     * @return true si nt es un Dk creado por la conversión.
+     */
+    bool AuxiliaryOrigin(const std::string& nt, size_t& production, size_t& position) const;
+
+    /**
+     * @brief Indica qué terminal representa un no terminal auxiliar Ca.
+     * @param nt Nombre del no terminal.
+     * @param t Terminal representado (salida).
+     * @return true si nt es un Ca creado por la conversión.
+     */
+    bool TerminalOf(const std::string& nt, char& t) const;
+
+    /**
+     * @brief Devuelve la correspondencia terminal -> Ca creada por la conversión.
+     * @return Referencia constante al mapa (vacío si no se ha convertido).
+     */
+    const std::map<char, std::string>& TerminalNonTerminals() const;
+
+    /**
+     * @brief Descompone el grafo de dependencias de los no terminales en
+     *        componentes fuertemente conexas, en orden topológico.
+     *
+     * Se calcula sobre las producciones actuales en tiempo lineal.
+     */
+    ComponentGraph Components() const;
+
+    /**
+     * @brief Calcula los no terminales generadores (los que derivan alguna cadena
+     *        de terminales) en tiempo lineal en el tamaño de la gramática.
+     *
+     * Cada componente de Components() se resuelve por separado a partir de
+     * las que usa; las componentes independientes se reparten entre hilos.
+     *
+     * @param threads Número de hilos (1 recorre las componentes en orden).
+     * @return Conjunto de no terminales generadores.
+     */
+    std::set<std::string> GeneratingNonTerminals(unsigned threads = 1) const;
+
+    /**
+     * @brief Calcula los no terminales anulables (los que derivan la cadena
+     *        vacía), por componentes como GeneratingNonTerminals().
+     * @param threads Número de hilos.
+     * @return Conjunto de no terminales anulables.
+     */
+    std::set<std::string> NullableNonTerminals(unsigned threads = 1) const;
+
+    /**
+     * @brief Indica si el lenguaje generado es vacío (el símbolo de arranque no es generador).
+     */
+    bool IsEmpty() const;
+
+    /**
+     * @brief Indica si el lenguaje generado es finito.
+     *
+     * Busca un ciclo en el grafo de dependencias de los no terminales útiles
+     * (generadores y alcanzables desde el arranque). Tiempo lineal.
+     * Precondición: sin producciones vacías ni unitarias (por ejemplo, tras
+     * TransformToCNF()), para que todo ciclo implique un lenguaje infinito.
+     *
+     * @param cycle Si no es nullptr y el lenguaje es infinito, recibe un ciclo
+     *        testigo A1, A2, ..., Ak, A1.
+     * @return true si el lenguaje es finito.
+     */
+    bool IsFinite(std::vector<std::string>* cycle = nullptr) const;
+
+    /**
+     * @brief Conjuntos FIRST de los no terminales.
+     *
+     * FIRST(A) contiene los terminales con los que empieza alguna cadena
+     * derivable desde A, y el especial (epsilon) si A es anulable. Se calcula
+     * sobre el grafo "A depende de B" (A -> alfa B beta con alfa anulable)
+     * recorriendo sus componentes fuertemente conexas en orden topológico
+     * inverso: todos los miembros de una componente tienen el mismo conjunto,
+     * que se obtiene en una sola pasada a partir de los ya calculados.
+     *
+     * @return Conjuntos FIRST empaquetados en palabras de 64 bits.
+     */
+    TerminalSets FirstSets() const;
+
+    /**
+     * @brief Conjuntos FOLLOW de los no terminales.
+     *
+     * FOLLOW(B) contiene los terminales que pueden seguir a B en alguna forma
+     * sentencial, y el especial (fin de cadena) si B puede aparecer al final;
+     * el símbolo de arranque siempre lo contiene. Se calcula como FirstSets()
+     * sobre el grafo "B hereda de A" (A -> alfa B beta con beta anulable).
+     *
+     * @return Conjuntos FOLLOW empaquetados en palabras de 64 bits.
+     */
+    TerminalSets FollowSets() const;
+
+    /**
+     * @brief Clasifica cada no terminal según la forma de las reglas de todos
+     *        los no terminales alcanzables desde él.
+     *
+     * Un no terminal es lineal por la derecha (por la izquierda) si todas las
+     * reglas de su subgramática lo son; si solo tiene reglas de terminales
+     * cumple ambas formas y se clasifica como kRight. Se calcula sobre las
+     * producciones actuales, así que se usa antes de TransformToCNF().
+     *
+     * @return Forma de cada no terminal, en el orden de NonTerminals().
+     */
+    std::vector<Linearity> LinearNonTerminals() const;
+
+    /**
+     * @brief Indica qué no terminales generan un lenguaje regular, aunque su
+     *        subgramática no sea lineal.
+     *
+     * Se recorren las componentes fuertemente conexas del grafo A -> B (B en
+     * una regla de A) desde las hojas. Una componente es regular si todos los
+     * no terminales de otras componentes que usa son regulares y, respecto a
+     * sus propios miembros, todas sus reglas son lineales por la derecha (kRight)
+     * o todas por la izquierda (kLeft); así ninguna es autoincrustada. Las
+     * componentes sin reglas recursivas se clasifican como kRight.
+     *
+     * @param component Si no es nulo, recibe la componente de cada no
+     *        terminal (numeradas de modo que las dependencias van primero).
+     * @return Forma de la componente de cada no terminal (kNone si no es
+     *         regular), en el orden de NonTerminals().
+     */
+    std::vector<Linearity> RegularNonTerminals(std::vector<int>* component = nullptr) const;
+
+    /**
+     * @brief Elimina todas las producciones de los no terminales dados, que
+     *        siguen declarados y quedan como hojas sin reglas.
+     * @param nts Nombres de los no terminales.
      */
-    std::set<char> DeclaredNonTerminals() const;
+    void RemoveProductionsOf(const std::set<std::string>& nts);
+
+    /**
+     * @brief Agrupa los terminales en clases de equivalencia.
+     *
+     * Dos terminales son equivalentes si aparecen exactamente en las mismas
+     * posiciones de las mismas reglas (con el resto de la regla idéntico).
+     * Las clases se numeran en el orden del conjunto de terminales.
+     *
+     * @param class_of Tabla byte -> clase (salida); -1 si el byte no es un terminal.
+     * @return número de clases.
+     */
+    int TerminalClasses(std::array<int, 256>& class_of) const;
+
+    /**
+     * @brief Hace que TransformToCNF() cree un único Ca por clase de terminales.
+     *
+     * El Ca de una clase se nombra por su primer terminal y tiene una regla
+     * Ca -> t por cada terminal t de la clase; las reglas que solo se
+     * diferencian en terminales equivalentes quedan repetidas y se eliminan.
+     * TerminalOf() devuelve entonces el primer terminal de la clase y
+     * AuxiliaryOrigin() la primera producción original de cada grupo.
+     *
+     * ConvertStreaming() y ConvertPipelined() no admiten la agrupación.
+     *
+     * @param enabled true para agrupar los terminales.
+     */
+    void SetTerminalGrouping(bool enabled);
+
+    /**
+     * @brief Fusiona los no terminales con conjuntos de reglas idénticos.
+     *
+     * Refina una partición de los no terminales (inicialmente un único bloque)
+     * agrupando por la firma de sus reglas, en la que cada no terminal de la
+     * RHS se sustituye por su bloque actual, hasta que la partición no cambia.
+     * Después cada bloque se sustituye por un representante (el símbolo de
+     * arranque si está en el bloque, si no un no terminal de la entrada antes
+     * que un auxiliar) y se eliminan las producciones repetidas.
+     *
+     * @return Número de no terminales y producciones eliminados.
+     */
+    MergeStats MergeEquivalentNonTerminals();
 
 private:
     /**
@@ -152,9 +516,9 @@ private:
     /**
      * @brief Conjunto de símbolos no terminales (cadenas alfanuméricas).
      *
-     * En la entrada se requiere que los no terminales sean una sola letra mayúscula.
-     * Sin embargo, la transformación puede añadir nuevos no terminales
-     * (ej Ca, D1, etc).
+     * En la entrada se requiere que los no terminales empiecen por una letra
+     * mayúscula (en el formato original, una sola letra). La transformación
+     * puede añadir nuevos no terminales (ej Ca, D1, etc).
      */
     std::set<std::string> nonterminals_;
 
@@ -180,6 +544,16 @@ private:
      */
     std::map<char, std::string> terminal_to_nt_;
 
+    /**
+     * @brief Copia de las producciones previas a la conversión.
+     */
+    std::vector<Production> source_productions_;
+
+    /**
+     * @brief Origen de cada Dk: nombre -> (producción original, posición del sufijo).
+     */
+    std::map<std::string, std::pair<size_t, size_t>> aux_origin_;
+
     /**
      * @brief Genera un nuevo nombre para un no terminal de tipo Dk.
      * @return nombre único (ej "D1", "D2", etc).
@@ -193,12 +567,105 @@ private:
      */
     std::string TerminalToNonTerminal(char t);
 
+    /**
+     * @brief Reinicia la gramática y lee la cabecera de un fichero .gra.
+     * @param is Flujo de entrada.
+     * @return número de producciones anunciado en la cabecera.
+     */
+    int ReadHeader(std::istream& is);
+
+    /**
+     * @brief Lee la siguiente producción de is y separa su RHS en símbolos.
+     *
+     * Solo consulta datos de la cabecera (input_terminals_ y los ids de los
+     * no terminales de la entrada), no terminals_ ni nonterminals_.
+     */
+    Production ReadProductionLine(std::istream& is) const;
+
+    /**
+     * @brief Indica si name es un no terminal declarado en la entrada.
+     */
+    bool IsInputNonTerminal(const std::string& name) const;
+
+    /**
+     * @brief Escribe una producción como una línea del fichero .gra.
+     */
+    void WriteProduction(std::ostream& os, const Production& p) const;
+
+    /**
+     * @brief Lanza si está activada la agrupación de terminales (method: quien llama).
+     */
+    void RejectTerminalGrouping(const char* method) const;
+
+    /**
+     * @brief Aplica el Algoritmo 1 a la producción p y añade sus reglas a rules.
+     */
+    void ConvertProduction(Production& p, std::vector<Production>& rules);
+
+    /**
+     * @brief Escribe en output la cabecera, las written reglas de spool_path y las Ca -> a.
+     */
+    void WriteAssembled(const std::string& output, const std::string& spool_path, size_t written) const;
+
     /**
      * @brief Función auxiliar que convierte una rhs (vector de tokens) en una única cadena
      * adecuada para escribir en el fichero .gra (se concatenan las representaciones).
      * @param rhs Vector de tokens de la rhs.
      */
     static std::string RhsToString(const std::vector<std::string>& rhs);
+
+    /**
+     * @brief Tabla de internado de símbolos: cadena -> id.
+     */
+    std::unordered_map<std::string, int> symbol_ids_;
+
+    /**
+     * @brief Nombres de los símbolos internados: id -> cadena.
+     */
+    std::vector<std::string> symbol_names_;
+
+    /**
+     * @brief Número de no terminales declarados en la entrada (ids 0..n-1).
+     */
+    int num_input_nonterminals_ = 0;
+
+    /**
+     * @brief Terminales declarados en la entrada, por byte. Solo lo escribe
+     *        ReadHeader(), así que ReadProductionLine() puede consultarlo
+     *        mientras la conversión añade símbolos a terminals_.
+     */
+    std::array<bool, 256> input_terminals_{};
+
+    /**
+     * @brief La entrada declara no terminales de varios caracteres; la salida
+     *        separa entonces los símbolos de cada RHS con espacios.
+     */
+    bool extended_syntax_ = false;
+
+    /**
+     * @brief TransformToCNF() crea un Ca por clase de terminales (ver SetTerminalGrouping()).
+     */
+    bool group_terminals_ = false;
+
+    /**
+     * @brief Clase de cada byte calculada al convertir con agrupamiento (-1 si no es terminal).
+     */
+    std::array<int, 256> terminal_class_{};
+
+    /**
+     * @brief Devuelve el id interno del símbolo s, asignándole uno nuevo si no lo tiene.
+     */
+    int InternSymbol(const std::string& s);
+
+    /**
+     * @brief Clave hash de una producción: ids internados de LHS y RHS.
+     */
+    std::vector<int> ProductionKey(const Production& p);
+
+    /**
+     * @brief Elimina las producciones repetidas conservando la primera aparición.
+     */
+    void RemoveDuplicateProductions();
 };
 
 #endif
\ No newline at end of file
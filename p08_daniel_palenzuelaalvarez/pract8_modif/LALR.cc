@@ -0,0 +1,440 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: LALR.cc: Implementación de las tablas LALR(1) y del analizador LR.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file LALR.cc
+ * @brief Implementación de CombTable, LALRTable y LRParser.
+ */
+
+#include "LALR.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+#include "Digraph.h"
+
+/**
+ * @brief Máximo de celdas (estado, símbolo) del índice denso de transiciones.
+ */
+static const size_t kDenseGotoLimit = size_t(1) << 25;
+
+/**
+ * @brief Hash de un núcleo LR(0) (ids de ítems ordenados), FNV-1a.
+ */
+struct KernelHash {
+    size_t operator()(const std::vector<int>& kernel) const {
+        uint64_t h = 1469598103934665603ULL;
+        for (int v : kernel) {
+            h ^= static_cast<uint32_t>(v);
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * @brief Coloca las filas de más a menos entradas en el primer desplazamiento
+ *        en el que no pisan ninguna posición ocupada.
+ */
+void CombTable::Build(const std::vector<std::vector<std::pair<int, int32_t>>>& rows,
+                      const std::vector<int32_t>& defaults) {
+    const size_t n = rows.size();
+    base_.assign(n, 0);
+    default_ = defaults;
+    check_.clear();
+    value_.clear();
+
+    std::vector<int> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = static_cast<int>(i);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return rows[a].size() > rows[b].size(); });
+
+    size_t first_free = 0; // antes de esta posición no queda ningún hueco
+    for (int row : order) {
+        const auto& entries = rows[row];
+        if (entries.empty()) continue;
+        int min_col = entries[0].first;
+        for (const auto& e : entries) min_col = std::min(min_col, e.first);
+        long base = static_cast<long>(first_free) - min_col;
+        if (base < 0) base = 0;
+        for (;; ++base) {
+            bool fits = true;
+            for (const auto& e : entries) {
+                const size_t k = static_cast<size_t>(base + e.first);
+                if (k < check_.size() && check_[k] >= 0) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) break;
+        }
+        base_[row] = static_cast<int32_t>(base);
+        for (const auto& e : entries) {
+            const size_t k = static_cast<size_t>(base + e.first);
+            if (k >= check_.size()) {
+                check_.resize(k + 1, -1);
+                value_.resize(k + 1, 0);
+            }
+            check_[k] = row;
+            value_[k] = e.second;
+        }
+        while (first_free < check_.size() && check_[first_free] >= 0) ++first_free;
+    }
+}
+
+size_t CombTable::Bytes() const {
+    return (base_.size() + default_.size() + check_.size() + value_.size()) * sizeof(int32_t);
+}
+
+/**
+ * @brief Construcción completa:
+ *  1) Numeración de símbolos y reglas (con S' -> S como regla 0).
+ *  2) Colección canónica LR(0): estados identificados por su núcleo.
+ *  3) Lookaheads: Read = DR ∪ reads*, Follow = Read ∪ includes*, y
+ *     LA(q, A -> w) = ∪ Follow(p, A) para cada (q, A -> w) lookback (p, A).
+ *  4) Acciones de cada celda, conflictos y tablas comprimidas.
+ */
+LALRTable LALRTable::Build(const Grammar& g) {
+    LALRTable t;
+    // FIRST aporta la numeración de terminales y no terminales y la anulabilidad
+    TerminalSets first = g.FirstSets();
+    const int num_t = static_cast<int>(first.terminals.size());
+    const int end = num_t;
+    const int nt_base = num_t + 1;
+    const int num_nt = static_cast<int>(first.nonterminals.size());
+
+    t.terminal_id_.fill(-1);
+    for (int i = 0; i < num_t; ++i) {
+        t.terminal_id_[static_cast<unsigned char>(first.terminals[i])] = i;
+        t.terminal_names_.push_back(std::string(1, first.terminals[i]));
+    }
+    t.terminal_names_.push_back("$");
+    t.nonterminal_names_ = first.nonterminals;
+    std::unordered_map<std::string, int> nt_id;
+    for (int i = 0; i < num_nt; ++i) nt_id[first.nonterminals[i]] = i;
+    std::vector<bool> nullable(num_nt);
+    for (int i = 0; i < num_nt; ++i) nullable[i] = first.Has(i, first.Special());
+
+    // 1) Reglas
+    t.rule_lhs_.push_back(-1);
+    t.rule_start_.push_back(0);
+    t.rule_rhs_.push_back(nt_base + nt_id.at(g.StartSymbol()));
+    for (const auto& p : g.Productions()) {
+        t.rule_lhs_.push_back(nt_id.at(p.lhs));
+        t.rule_start_.push_back(static_cast<int>(t.rule_rhs_.size()));
+        if (p.IsEmpty()) continue;
+        for (const auto& tok : p.rhs) {
+            auto it = nt_id.find(tok);
+            t.rule_rhs_.push_back(it != nt_id.end() ? nt_base + it->second
+                                                    : t.terminal_id_[static_cast<unsigned char>(tok[0])]);
+        }
+    }
+    t.rule_start_.push_back(static_cast<int>(t.rule_rhs_.size()));
+    const int num_rules = static_cast<int>(t.rule_lhs_.size());
+
+    std::vector<std::vector<int>> rules_by_lhs(num_nt);
+    for (int r = 1; r < num_rules; ++r) rules_by_lhs[t.rule_lhs_[r]].push_back(r);
+    // Un ítem (r, punto) se numera item_base[r] + punto
+    std::vector<int> item_base(num_rules + 1, 0), item_rule;
+    for (int r = 0; r < num_rules; ++r) {
+        item_base[r + 1] = item_base[r] + t.RuleLength(r) + 1;
+        for (int d = 0; d <= t.RuleLength(r); ++d) item_rule.push_back(r);
+    }
+    // Menor posición a partir de la cual la RHS de cada regla es anulable
+    std::vector<int> nullable_from(num_rules);
+    for (int r = 0; r < num_rules; ++r) {
+        int k = t.RuleLength(r);
+        while (k > 0) {
+            int x = t.rule_rhs_[t.rule_start_[r] + k - 1];
+            if (x < nt_base || !nullable[x - nt_base]) break;
+            --k;
+        }
+        nullable_from[r] = k;
+    }
+
+    // 2) Colección LR(0). Transiciones y reducciones de todos los estados en
+    // vectores contiguos: el estado s ocupa [trans_start[s], trans_start[s + 1])
+    std::unordered_map<std::vector<int>, int, KernelHash> state_of;
+    std::vector<std::vector<int>> kernels{{item_base[0]}};
+    state_of.emplace(kernels[0], 0);
+    std::vector<size_t> trans_start{0}, red_start{0};
+    std::vector<int> trans_sym, trans_to; // símbolo (ordenados en cada estado) y destino
+    std::vector<int> red_rule;            // reglas completas (ordenadas en cada estado)
+    std::vector<int> mark(num_nt, -1);
+    std::vector<int> items;
+    std::map<int, std::vector<int>> next;
+    for (size_t s = 0; s < kernels.size(); ++s) {
+        items = kernels[s];
+        for (size_t i = 0; i < items.size(); ++i) {
+            const int r = item_rule[items[i]];
+            const int d = items[i] - item_base[r];
+            if (d == t.RuleLength(r)) continue;
+            const int x = t.rule_rhs_[t.rule_start_[r] + d];
+            if (x < nt_base || mark[x - nt_base] == static_cast<int>(s)) continue;
+            mark[x - nt_base] = static_cast<int>(s);
+            for (int r2 : rules_by_lhs[x - nt_base]) items.push_back(item_base[r2]);
+        }
+        next.clear();
+        const size_t red_begin = red_rule.size();
+        for (int it : items) {
+            const int r = item_rule[it];
+            const int d = it - item_base[r];
+            if (d == t.RuleLength(r)) red_rule.push_back(r);
+            else next[t.rule_rhs_[t.rule_start_[r] + d]].push_back(it + 1);
+        }
+        std::sort(red_rule.begin() + red_begin, red_rule.end());
+        red_start.push_back(red_rule.size());
+        for (auto& [x, kernel] : next) {
+            std::sort(kernel.begin(), kernel.end());
+            auto ins = state_of.emplace(kernel, static_cast<int>(kernels.size()));
+            if (ins.second) kernels.push_back(std::move(kernel));
+            trans_sym.push_back(x);
+            trans_to.push_back(ins.first->second);
+        }
+        trans_start.push_back(trans_sym.size());
+    }
+    t.num_states_ = kernels.size();
+    const int num_states = static_cast<int>(t.num_states_);
+    state_of.clear();
+    kernels.clear();
+
+    // Posición de la transición de s con x en trans_sym/trans_to (npos si no
+    // existe). Los recorridos de includes/lookback hacen una consulta por
+    // símbolo de cada regla y transición, así que se usa un índice denso
+    // estado x símbolo si no es demasiado grande, y búsqueda binaria si lo es.
+    const size_t npos = static_cast<size_t>(-1);
+    const size_t num_sym = static_cast<size_t>(nt_base + num_nt);
+    std::vector<int> dense;
+    if (static_cast<size_t>(num_states) * num_sym <= kDenseGotoLimit) {
+        dense.assign(static_cast<size_t>(num_states) * num_sym, -1);
+        for (int s = 0; s < num_states; ++s) {
+            for (size_t k = trans_start[s]; k < trans_start[s + 1]; ++k) dense[s * num_sym + trans_sym[k]] = static_cast<int>(k);
+        }
+    }
+    auto go = [&](int s, int x) {
+        if (!dense.empty()) {
+            const int k = dense[s * num_sym + x];
+            return k < 0 ? npos : static_cast<size_t>(k);
+        }
+        auto first = trans_sym.begin() + trans_start[s], last = trans_sym.begin() + trans_start[s + 1];
+        auto it = std::lower_bound(first, last, x);
+        return it != last && *it == x ? static_cast<size_t>(it - trans_sym.begin()) : npos;
+    };
+
+    // 3) Transiciones con no terminal (p, A), numeradas
+    std::vector<int> nt_trans_id(trans_sym.size(), -1);
+    std::vector<std::pair<int, int>> nt_trans; // id -> (estado, no terminal)
+    for (int s = 0; s < num_states; ++s) {
+        for (size_t k = trans_start[s]; k < trans_start[s + 1]; ++k) {
+            if (trans_sym[k] < nt_base) continue;
+            nt_trans_id[k] = static_cast<int>(nt_trans.size());
+            nt_trans.emplace_back(s, trans_sym[k] - nt_base);
+        }
+    }
+    const size_t m = nt_trans.size();
+    const size_t w = (static_cast<size_t>(num_t) + 1 + 63) / 64;
+    auto set_bit = [&](std::vector<uint64_t>& sets, size_t i, int b) {
+        sets[i * w + b / 64] |= uint64_t(1) << (b % 64);
+    };
+
+    // DR y reads
+    std::vector<uint64_t> follow(m * w, 0);
+    std::vector<std::vector<int>> reads(m);
+    for (size_t i = 0; i < m; ++i) {
+        const int p = nt_trans[i].first, a = nt_trans[i].second;
+        const int r = trans_to[go(p, nt_base + a)];
+        for (size_t k = trans_start[r]; k < trans_start[r + 1]; ++k) {
+            const int x = trans_sym[k];
+            if (x < nt_base) set_bit(follow, i, x);
+            else if (nullable[x - nt_base]) reads[i].push_back(nt_trans_id[k]);
+        }
+        if (p == 0 && t.rule_rhs_[0] == nt_base + a) set_bit(follow, i, end);
+    }
+    SolveSetEquations(reads, w, follow);
+    reads.clear();
+
+    // includes y lookback: se recorre cada regla de B desde cada transición (p', B)
+    std::vector<std::vector<int>> includes(m);
+    std::vector<std::pair<size_t, int>> lookback; // (posición en red_rule, transición)
+    for (size_t i = 0; i < m; ++i) {
+        const int p0 = nt_trans[i].first, b = nt_trans[i].second;
+        for (int r : rules_by_lhs[b]) {
+            int s = p0;
+            for (int k = 0; k < t.RuleLength(r); ++k) {
+                const int x = t.rule_rhs_[t.rule_start_[r] + k];
+                const size_t pos = go(s, x);
+                if (x >= nt_base && k + 1 >= nullable_from[r]) includes[nt_trans_id[pos]].push_back(static_cast<int>(i));
+                s = trans_to[pos];
+            }
+            auto first = red_rule.begin() + red_start[s], last = red_rule.begin() + red_start[s + 1];
+            lookback.emplace_back(static_cast<size_t>(std::lower_bound(first, last, r) - red_rule.begin()),
+                                  static_cast<int>(i));
+        }
+    }
+    SolveSetEquations(includes, w, follow);
+    includes.clear();
+
+    std::vector<uint64_t> la(red_rule.size() * w, 0);
+    for (const auto& [k, i] : lookback) {
+        for (size_t j = 0; j < w; ++j) la[k * w + j] |= follow[i * w + j];
+    }
+    lookback.clear();
+    // S' -> S. solo se reduce (acepta) con el fin de cadena
+    const int accept_state = trans_to[go(0, t.rule_rhs_[0])];
+    set_bit(la, red_start[accept_state], end);
+
+    // 4) Acciones
+    const int cols = num_t + 1;
+    t.cell_start_.assign(static_cast<size_t>(num_states) * cols + 1, 0);
+    std::vector<std::vector<std::pair<int, int32_t>>> action_rows(num_states);
+    std::vector<int32_t> action_default(num_states, 0);
+    for (int s = 0; s < num_states; ++s) {
+        std::vector<std::pair<int, int32_t>> row;
+        std::map<int32_t, int> reduce_count;
+        for (int c = 0; c < cols; ++c) {
+            const size_t cell = static_cast<size_t>(s) * cols + c;
+            const size_t before = t.cell_actions_.size();
+            if (c < num_t) {
+                const size_t pos = go(s, c);
+                if (pos != npos) t.cell_actions_.push_back(Shift(trans_to[pos]));
+            }
+            for (size_t k = red_start[s]; k < red_start[s + 1]; ++k) {
+                if ((la[k * w + c / 64] >> (c % 64)) & 1) t.cell_actions_.push_back(Reduce(red_rule[k]));
+            }
+            t.cell_start_[cell + 1] = static_cast<uint32_t>(t.cell_actions_.size());
+            const size_t count = t.cell_actions_.size() - before;
+            if (count == 0) continue;
+            const int32_t chosen = t.cell_actions_[before];
+            if (count > 1) {
+                std::string msg = "Estado " + std::to_string(s) + ", '" + t.terminal_names_[c] + "': ";
+                msg += IsShift(chosen) ? "desplazamiento/reducción" : "reducción/reducción";
+                for (size_t k = before; k < t.cell_actions_.size(); ++k) {
+                    if (IsReduce(t.cell_actions_[k])) msg += " [" + t.RuleText(ReduceRule(t.cell_actions_[k])) + "]";
+                }
+                t.conflicts_.push_back(msg);
+            }
+            row.emplace_back(c, chosen);
+            if (IsReduce(chosen) && chosen != Reduce(0)) ++reduce_count[chosen];
+        }
+        // Reducción por defecto: la más frecuente (nunca la aceptación)
+        int best = 0;
+        for (const auto& [a, n] : reduce_count) {
+            if (n > best) {
+                best = n;
+                action_default[s] = a;
+            }
+        }
+        if (action_default[s] != 0) {
+            row.erase(std::remove_if(row.begin(), row.end(),
+                                     [&](const std::pair<int, int32_t>& e) { return e.second == action_default[s]; }),
+                      row.end());
+        }
+        action_rows[s] = std::move(row);
+    }
+    t.action_.Build(action_rows, action_default);
+
+    // Goto por columnas: para cada no terminal, el destino más frecuente es el de por defecto
+    std::vector<std::vector<std::pair<int, int32_t>>> goto_rows(num_nt);
+    std::vector<int32_t> goto_default(num_nt, -1);
+    for (const auto& [p, a] : nt_trans) goto_rows[a].emplace_back(p, trans_to[go(p, nt_base + a)]);
+    for (int a = 0; a < num_nt; ++a) {
+        std::map<int32_t, int> count;
+        int best = 0;
+        for (const auto& e : goto_rows[a]) {
+            if (++count[e.second] > best) {
+                best = count[e.second];
+                goto_default[a] = e.second;
+            }
+        }
+        auto& row = goto_rows[a];
+        row.erase(std::remove_if(row.begin(), row.end(),
+                                 [&](const std::pair<int, int32_t>& e) { return e.second == goto_default[a]; }),
+                  row.end());
+    }
+    t.goto_.Build(goto_rows, goto_default);
+    return t;
+}
+
+size_t LALRTable::NumStates() const { return num_states_; }
+
+size_t LALRTable::NumRules() const { return rule_lhs_.size(); }
+
+int LALRTable::EndMarker() const { return static_cast<int>(terminal_names_.size()) - 1; }
+
+const int32_t* LALRTable::Actions(int state, int t, size_t& count) const {
+    const size_t cell = static_cast<size_t>(state) * terminal_names_.size() + t;
+    count = cell_start_[cell + 1] - cell_start_[cell];
+    return cell_actions_.data() + cell_start_[cell];
+}
+
+int LALRTable::RuleLhs(int r) const { return rule_lhs_[r]; }
+
+int LALRTable::RuleLength(int r) const { return rule_start_[r + 1] - rule_start_[r]; }
+
+std::string LALRTable::SymbolText(int symbol) const {
+    const int nt_base = static_cast<int>(terminal_names_.size());
+    return symbol < nt_base ? terminal_names_[symbol] : nonterminal_names_[symbol - nt_base];
+}
+
+std::string LALRTable::RuleText(int r) const {
+    std::string out = (rule_lhs_[r] < 0 ? std::string("S'") : nonterminal_names_[rule_lhs_[r]]) + " -> ";
+    if (RuleLength(r) == 0) return out + "&";
+    for (int k = rule_start_[r]; k < rule_start_[r + 1]; ++k) out += SymbolText(rule_rhs_[k]);
+    return out;
+}
+
+const std::vector<std::string>& LALRTable::Conflicts() const { return conflicts_; }
+
+bool LALRTable::IsLALR1() const { return conflicts_.empty(); }
+
+size_t LALRTable::TableBytes() const { return action_.Bytes() + goto_.Bytes(); }
+
+size_t LALRTable::DenseBytes() const {
+    return num_states_ * (terminal_names_.size() + nonterminal_names_.size()) * sizeof(int32_t);
+}
+
+LRParser::LRParser(const LALRTable& table) : table_(table) {}
+
+/**
+ * @brief Bucle desplazamiento/reducción: cada terminal se desplaza una vez y,
+ *        en una gramática LALR(1), el número de reducciones es lineal.
+ */
+bool LRParser::Accepts(const std::string& word) const {
+    std::vector<int> stack{0};
+    size_t pos = 0;
+    auto next = [&]() {
+        return pos < word.size() ? table_.TerminalId(static_cast<unsigned char>(word[pos])) : table_.EndMarker();
+    };
+    int a = next();
+    if (a < 0) return false;
+    for (;;) {
+        const int32_t act = table_.Action(stack.back(), a);
+        if (act == 0) return false;
+        if (LALRTable::IsShift(act)) {
+            stack.push_back(LALRTable::ShiftTarget(act));
+            ++pos;
+            a = next();
+            if (a < 0) return false;
+            continue;
+        }
+        const int r = LALRTable::ReduceRule(act);
+        if (r == 0) return true;
+        stack.resize(stack.size() - table_.RuleLength(r));
+        stack.push_back(table_.Goto(stack.back(), table_.RuleLhs(r)));
+    }
+}
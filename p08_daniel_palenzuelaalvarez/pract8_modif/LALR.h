@@ -0,0 +1,220 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: LALR.h: Tablas LALR(1) de la gramática de entrada y analizador LR.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+ *    F. DeRemer, T. Pennello. Efficient Computation of LALR(1) Look-Ahead Sets.
+ *    ACM TOPLAS 4(4), 1982.
+*/
+
+/**
+ * @file LALR.h
+ * @brief Autómata LR(0), lookaheads LALR(1) y tablas de análisis comprimidas.
+ *
+ * Se trabaja sobre la gramática original (antes de pasarla a FNC), ampliada
+ * con S' -> S. Las lookaheads se calculan con las relaciones reads, includes
+ * y lookback de DeRemer y Pennello, resueltas con SolveSetEquations().
+ *
+ * Numeración de símbolos en las reglas: los terminales van de 0 a T-1, el fin
+ * de cadena ($) es T y el no terminal A es T + 1 + A. Las acciones se
+ * codifican en un int32_t: 0 es error, s + 1 desplaza al estado s y -(r + 1)
+ * reduce por la regla r (la regla 0, S' -> S, es la aceptación).
+ */
+
+#ifndef LALR_H
+#define LALR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Grammar2CNF.h"
+
+/**
+ * @class CombTable
+ * @brief Tabla dispersa comprimida por desplazamiento de filas.
+ *
+ * Cada fila tiene un valor por defecto; el resto de entradas se colocan en un
+ * vector compartido a partir de base_[fila] (primer hueco donde caben todas),
+ * y check_ indica a qué fila pertenece cada posición.
+ */
+class CombTable {
+public:
+    /**
+     * @brief Construye la tabla.
+     * @param rows Entradas (columna, valor) de cada fila distintas del valor por defecto.
+     * @param defaults Valor por defecto de cada fila.
+     */
+    void Build(const std::vector<std::vector<std::pair<int, int32_t>>>& rows, const std::vector<int32_t>& defaults);
+
+    /**
+     * @brief Valor de la celda (row, col).
+     */
+    int32_t Get(int row, int col) const {
+        const size_t k = static_cast<size_t>(base_[row]) + static_cast<size_t>(col);
+        return k < check_.size() && check_[k] == row ? value_[k] : default_[row];
+    }
+
+    /**
+     * @brief Bytes ocupados por los vectores de la tabla.
+     */
+    size_t Bytes() const;
+
+private:
+    std::vector<int32_t> base_;    // fila -> desplazamiento
+    std::vector<int32_t> default_; // fila -> valor por defecto
+    std::vector<int32_t> check_;   // posición -> fila propietaria (-1 si libre)
+    std::vector<int32_t> value_;   // posición -> valor
+};
+
+/**
+ * @class LALRTable
+ * @brief Tablas de análisis LALR(1) de una gramática.
+ *
+ * Además de las tablas comprimidas (una acción por celda, resolviendo los
+ * conflictos a favor del desplazamiento y de la regla de menor índice),
+ * conserva la lista completa de acciones de cada celda.
+ */
+class LALRTable {
+public:
+    /**
+     * @brief Construye el autómata y las tablas de la gramática (tal como se
+     *        ha leído y validado; admite producciones vacías y unitarias).
+     */
+    static LALRTable Build(const Grammar& g);
+
+    /**
+     * @brief Número de estados del autómata LR(0).
+     */
+    size_t NumStates() const;
+
+    /**
+     * @brief Número de reglas (incluida S' -> S, que es la regla 0).
+     */
+    size_t NumRules() const;
+
+    /**
+     * @brief Id del terminal del byte c, o -1 si no es un terminal declarado.
+     */
+    int TerminalId(unsigned char c) const { return terminal_id_[c]; }
+
+    /**
+     * @brief Id del fin de cadena ($).
+     */
+    int EndMarker() const;
+
+    /**
+     * @brief Acción (resuelta) del estado state con el terminal t.
+     */
+    int32_t Action(int state, int t) const { return action_.Get(state, t); }
+
+    /**
+     * @brief Estado destino desde state con el no terminal a (tras una reducción).
+     */
+    int Goto(int state, int a) const { return goto_.Get(a, state); }
+
+    /**
+     * @brief Todas las acciones del estado state con el terminal t.
+     * @param count Número de acciones (salida).
+     * @return puntero a la primera acción.
+     */
+    const int32_t* Actions(int state, int t, size_t& count) const;
+
+    /**
+     * @brief No terminal de la LHS de la regla r (-1 para S').
+     */
+    int RuleLhs(int r) const;
+
+    /**
+     * @brief Longitud de la RHS de la regla r.
+     */
+    int RuleLength(int r) const;
+
+    /**
+     * @brief Regla r escrita como en el fichero .gra ("A -> aB").
+     */
+    std::string RuleText(int r) const;
+
+    /**
+     * @brief Descripción de cada celda con más de una acción.
+     */
+    const std::vector<std::string>& Conflicts() const;
+
+    /**
+     * @brief Indica si la gramática es LALR(1) (no hay conflictos).
+     */
+    bool IsLALR1() const;
+
+    /**
+     * @brief Bytes de las tablas comprimidas (acciones y goto).
+     */
+    size_t TableBytes() const;
+
+    /**
+     * @brief Bytes que ocuparían las tablas sin comprimir (un int32_t por celda).
+     */
+    size_t DenseBytes() const;
+
+    /**
+     * @brief Codificación de las acciones.
+     */
+    static int32_t Shift(int state) { return state + 1; }
+    static int32_t Reduce(int rule) { return -(rule + 1); }
+    static bool IsShift(int32_t a) { return a > 0; }
+    static bool IsReduce(int32_t a) { return a < 0; }
+    static int ShiftTarget(int32_t a) { return a - 1; }
+    static int ReduceRule(int32_t a) { return -a - 1; }
+
+private:
+    std::vector<std::string> terminal_names_;    // id -> terminal ("$" para el fin)
+    std::vector<std::string> nonterminal_names_; // id -> no terminal
+    std::array<int, 256> terminal_id_{};         // byte -> id de terminal (-1 si no existe)
+    std::vector<int> rule_lhs_;                  // regla -> no terminal (-1 para S')
+    std::vector<int> rule_start_;                // regla -> inicio de su RHS en rule_rhs_
+    std::vector<int> rule_rhs_;                  // RHS consecutivas (símbolos numerados)
+    size_t num_states_ = 0;
+
+    std::vector<uint32_t> cell_start_; // (estado, terminal) -> inicio en cell_actions_
+    std::vector<int32_t> cell_actions_; // acciones de cada celda, desplazamiento primero
+    std::vector<std::string> conflicts_;
+    CombTable action_; // filas: estados; columnas: terminales
+    CombTable goto_;   // filas: no terminales; columnas: estados
+
+    std::string SymbolText(int symbol) const;
+};
+
+/**
+ * @class LRParser
+ * @brief Analizador LR dirigido por las tablas LALR(1): tiempo lineal en la
+ *        longitud de la cadena.
+ */
+class LRParser {
+public:
+    /**
+     * @brief Prepara el analizador (las tablas no se copian y deben seguir vivas).
+     */
+    explicit LRParser(const LALRTable& table);
+
+    /**
+     * @brief Decide si la cadena pertenece al lenguaje de la gramática.
+     */
+    bool Accepts(const std::string& word) const;
+
+private:
+    const LALRTable& table_;
+};
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Mixed.cc: Implementación del reconocedor mixto AFD + CYK.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Mixed.cc
+ * @brief Implementación de MixedRecognizer.
+ */
+
+#include "Mixed.h"
+
+#include <set>
+
+/**
+ * @brief Clasifica los no terminales, convierte el núcleo (la gramática sin
+ *        las reglas de los regulares) y compila un AFD por cada regular que
+ *        aparece en alguna regla binaria del núcleo.
+ */
+MixedRecognizer::MixedRecognizer(const Grammar& g) {
+    const std::vector<Linearity> forms = g.RegularNonTerminals();
+    std::set<std::string> regular;
+    size_t i = 0;
+    for (const auto& nt : g.NonTerminals()) {
+        if (forms[i++] != Linearity::kNone) regular.insert(nt);
+    }
+    regular_names_.assign(regular.begin(), regular.end());
+    stats_.regular_nonterminals = regular.size();
+
+    if (regular.count(g.StartSymbol())) {
+        whole_.reset(new DFA(DFA::FromGrammar(g, g.StartSymbol())));
+        stats_.dfa_states = whole_->NumStates();
+        return;
+    }
+
+    Grammar core = g;
+    core.RemoveProductionsOf(regular);
+    core.TransformToCNF();
+    CNFIndex index = CNFIndex::FromGrammar(core);
+    std::set<int> used;
+    for (const auto& r : index.BinaryRules()) {
+        used.insert(r.left);
+        used.insert(r.right);
+    }
+    for (const auto& nt : regular) {
+        const int id = index.IdOf(nt);
+        if (id < 0 || !used.count(id)) continue;
+        leaves_.emplace_back(id, DFA::FromGrammar(g, nt));
+        stats_.dfa_states += leaves_.back().second.NumStates();
+    }
+    stats_.leaves = leaves_.size();
+    stats_.core_binary_rules = index.BinaryRules().size();
+    core_.reset(new CYKRecognizer(index));
+}
+
+/**
+ * @brief Siembra cada hoja en las subcadenas que acepta su AFD y rellena la
+ *        tabla CYK del núcleo.
+ */
+bool MixedRecognizer::Accepts(const std::string& word) const {
+    if (whole_) return whole_->Accepts(word);
+    // Una gramática en FNC (sin producción vacía) no genera la cadena vacía
+    if (word.empty()) return false;
+    const size_t n = word.size();
+    std::vector<CYKSeed> seeds;
+    for (const auto& leaf : leaves_) {
+        const DFA& dfa = leaf.second;
+        for (size_t i = 0; i < n; ++i) {
+            int32_t s = dfa.Start();
+            for (size_t j = i; j < n; ++j) {
+                s = dfa.Next(s, static_cast<unsigned char>(word[j]));
+                if (s == 0) break;
+                if (dfa.Accepting(s)) seeds.push_back(CYKSeed{i, j - i + 1, leaf.first});
+            }
+        }
+    }
+    return core_->Fill(word, seeds).Has(0, n, core_->Index().Start());
+}
+
+const MixedStats& MixedRecognizer::Stats() const { return stats_; }
+
+const std::vector<std::string>& MixedRecognizer::RegularNames() const { return regular_names_; }
@@ -0,0 +1,94 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Mixed.h: Reconocedor que combina AFD para las partes regulares y CYK.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Mixed.h
+ * @brief Descomposición de una gramática en partes regulares y núcleo
+ *        independiente del contexto.
+ *
+ * Los no terminales regulares (Grammar::RegularNonTerminals()) se compilan a
+ * AFD y pasan a ser hojas del núcleo: se eliminan sus reglas antes de la
+ * conversión a FNC y, para cada cadena, se siembran en la tabla CYK todas las
+ * subcadenas que acepta su AFD. El bucle de CYK recorre así solo las reglas
+ * binarias del núcleo.
+ */
+
+#ifndef MIXED_H
+#define MIXED_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CYK.h"
+#include "Regular.h"
+
+/**
+ * @brief Tamaño de la descomposición.
+ */
+struct MixedStats {
+    size_t regular_nonterminals = 0; // no terminales con lenguaje regular
+    size_t leaves = 0;               // de ellos, los usados por el núcleo
+    size_t dfa_states = 0;           // estados de todos los AFD
+    size_t core_binary_rules = 0;    // reglas binarias de la FNC del núcleo
+};
+
+/**
+ * @class MixedRecognizer
+ * @brief Reconocedor con hojas regulares resueltas por AFD y CYK sobre el núcleo.
+ *
+ * Si el propio símbolo de arranque es regular no hay núcleo y se usa solo su
+ * AFD. Sembrar las hojas cuesta O(n^2) pasos de AFD por hoja en el peor caso
+ * (cada AFD se ejecuta desde cada posición hasta llegar al estado de error).
+ */
+class MixedRecognizer {
+public:
+    /**
+     * @brief Descompone y compila la gramática.
+     * @param g Gramática de entrada validada y sin convertir (sin producciones
+     *        vacías ni unitarias, como exige TransformToCNF()).
+     * @throws std::runtime_error Si falla la conversión del núcleo o la
+     *         compilación de algún AFD.
+     */
+    explicit MixedRecognizer(const Grammar& g);
+
+    /**
+     * @brief Decide si la cadena pertenece al lenguaje de la gramática.
+     */
+    bool Accepts(const std::string& word) const;
+
+    /**
+     * @brief Tamaño de la descomposición.
+     */
+    const MixedStats& Stats() const;
+
+    /**
+     * @brief Nombres de los no terminales regulares.
+     */
+    const std::vector<std::string>& RegularNames() const;
+
+private:
+    std::unique_ptr<DFA> whole_;           // AFD del arranque, si es regular
+    std::unique_ptr<CYKRecognizer> core_;  // CYK del núcleo en otro caso
+    std::vector<std::pair<int, DFA>> leaves_; // id en el núcleo -> AFD
+    std::vector<std::string> regular_names_;
+    MixedStats stats_;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: OnlineCYK.cc: Implementación del reconocedor CYK incremental.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file OnlineCYK.cc
+ * @brief Implementación de OnlineRecognizer.
+ */
+
+#include "OnlineCYK.h"
+
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Indica si a y b tienen algún bit común en las posiciones [from, to).
+ */
+bool Meets(const uint64_t* a, const uint64_t* b, size_t from, size_t to) {
+    if (from >= to) return false;
+    const size_t w0 = from / 64, w1 = (to - 1) / 64;
+    for (size_t w = w0; w <= w1; ++w) {
+        uint64_t x = a[w] & b[w];
+        if (w == w0) x &= ~uint64_t(0) << (from % 64);
+        if (w == w1 && to % 64 != 0) x &= ~uint64_t(0) >> (64 - to % 64);
+        if (x) return true;
+    }
+    return false;
+}
+
+bool Test(const uint64_t* set, size_t bit) { return (set[bit / 64] >> (bit % 64)) & 1; }
+
+void Add(uint64_t* set, size_t bit) { set[bit / 64] |= uint64_t(1) << (bit % 64); }
+
+} // namespace
+
+/**
+ * @brief Calcula los no terminales productivos y, con ellos, el cierre por
+ *        la izquierda: si B está en el cierre de un prefijo y hay una regla
+ *        A -> BC con C productivo, A también lo está.
+ */
+OnlineRecognizer::OnlineRecognizer(const CNFIndex& index)
+    : index_(index),
+      nts_(static_cast<size_t>(index.NumNonTerminals())),
+      nt_words_((nts_ + 63) / 64),
+      unary_by_char_(256) {
+    std::vector<bool> productive(nts_, false);
+    for (const auto& r : index_.UnaryRules()) {
+        unary_by_char_[static_cast<unsigned char>(r.terminal)].push_back(r.lhs);
+        productive[r.lhs] = true;
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto& r : index_.BinaryRules()) {
+            if (!productive[r.lhs] && productive[r.left] && productive[r.right]) {
+                productive[r.lhs] = true;
+                changed = true;
+            }
+        }
+    }
+
+    closure_.assign(nts_ * nt_words_, 0);
+    for (size_t a = 0; a < nts_; ++a) Add(&closure_[a * nt_words_], a);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto& r : index_.BinaryRules()) {
+            if (!productive[r.right]) continue;
+            uint64_t* dst = &closure_[r.left * nt_words_];
+            const uint64_t* src = &closure_[r.lhs * nt_words_];
+            for (size_t w = 0; w < nt_words_; ++w) {
+                if ((dst[w] | src[w]) != dst[w]) {
+                    dst[w] |= src[w];
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rellena la columna e = n + 1 de abajo arriba.
+ *
+ * Para cada celda (i, e) se calcula T, los A que generan w[i..e), y Pre, los
+ * A de los que w[i..e) es prefijo de alguna cadena generada:
+ *   T(i, e)   = { A | A -> BC, B en T(i, k), C en T(k, e), i < k < e }
+ *   Pre(i, e) = cierre( T(i, e) U { A | A -> BC, B en T(i, k), C en Pre(k, e) } )
+ * Las filas T(i, k) con k < e ya están calculadas y las columnas T(k, e) y
+ * Pre(k, e) con k > i se acaban de rellenar, así que no se recalcula nada de
+ * los pasos anteriores. Pre solo se necesita dentro del paso.
+ */
+OnlineStep OnlineRecognizer::Push(char c) {
+    if (dead_) {
+        ++n_;
+        return OnlineStep{false, false};
+    }
+    const size_t e = n_ + 1;
+    if (e / 64 >= words_) GrowRows();
+    rows_.emplace_back(nts_ * words_, 0);
+    col_t_.assign(nts_ * words_, 0);
+    col_pre_.assign(nts_ * words_, 0);
+
+    std::vector<uint64_t> cell(nt_words_), pre(nt_words_), base(nt_words_);
+    const auto& rules = index_.BinaryRules();
+    for (size_t i = e; i-- > 0;) {
+        std::fill(cell.begin(), cell.end(), 0);
+        if (i + 1 == e) {
+            for (int a : unary_by_char_[static_cast<unsigned char>(c)]) Add(cell.data(), a);
+        } else {
+            for (const auto& r : rules) {
+                if (!Test(cell.data(), r.lhs) && Meets(Row(r.left, i), &col_t_[r.right * words_], i + 1, e))
+                    Add(cell.data(), r.lhs);
+            }
+        }
+        base = cell;
+        if (i + 1 < e) {
+            for (const auto& r : rules) {
+                if (!Test(base.data(), r.lhs) && Meets(Row(r.left, i), &col_pre_[r.right * words_], i + 1, e))
+                    Add(base.data(), r.lhs);
+            }
+        }
+        std::fill(pre.begin(), pre.end(), 0);
+        for (size_t b = 0; b < nts_; ++b) {
+            if (!Test(base.data(), b)) continue;
+            const uint64_t* up = &closure_[b * nt_words_];
+            for (size_t w = 0; w < nt_words_; ++w) pre[w] |= up[w];
+        }
+        for (size_t a = 0; a < nts_; ++a) {
+            if (Test(cell.data(), a)) {
+                Add(&col_t_[a * words_], i);
+                Add(Row(static_cast<int>(a), i), e);
+            }
+            if (Test(pre.data(), a)) Add(&col_pre_[a * words_], i);
+        }
+    }
+    n_ = e;
+
+    const size_t start = static_cast<size_t>(index_.Start());
+    OnlineStep step{Test(&col_t_[start * words_], 0), Test(&col_pre_[start * words_], 0)};
+    // Ningún prefijo más largo puede ser viable: se libera la tabla
+    if (!step.viable) {
+        dead_ = true;
+        rows_.clear();
+    }
+    return step;
+}
+
+/**
+ * @brief Añade una palabra a todas las filas (cada 64 caracteres, así que el
+ *        coste amortizado por carácter es lineal en el número de filas).
+ */
+void OnlineRecognizer::GrowRows() {
+    const size_t old_words = words_;
+    ++words_;
+    for (auto& block : rows_) {
+        std::vector<uint64_t> grown(nts_ * words_, 0);
+        for (size_t a = 0; a < nts_; ++a) {
+            std::copy(block.begin() + a * old_words, block.begin() + (a + 1) * old_words, grown.begin() + a * words_);
+        }
+        block.swap(grown);
+    }
+}
+
+void OnlineRecognizer::Reset() {
+    n_ = 0;
+    dead_ = false;
+    words_ = 0;
+    rows_.clear();
+}
+
+size_t OnlineRecognizer::Length() const { return n_; }
@@ -0,0 +1,102 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: OnlineCYK.h: Reconocedor CYK incremental por prefijos.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file OnlineCYK.h
+ * @brief Reconocedor CYK que procesa la entrada carácter a carácter.
+ *
+ * La tabla se rellena por columnas: al llegar el carácter e-ésimo se calculan
+ * solo las celdas (i, e) de las subcadenas que terminan en él, de abajo
+ * arriba, sin tocar las columnas anteriores. Cada no terminal guarda, por
+ * posición de inicio i, una fila de bits con las posiciones finales k tales
+ * que genera w[i..k), de modo que cada corte se comprueba con una
+ * intersección de palabras de 64 bits.
+ *
+ * Además de la pertenencia, cada paso indica si el prefijo leído es viable,
+ * es decir, si alguna continuación lo convierte en una cadena del lenguaje.
+ */
+
+#ifndef ONLINE_CYK_H
+#define ONLINE_CYK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CYK.h"
+
+/**
+ * @brief Resultado de añadir un carácter.
+ */
+struct OnlineStep {
+    bool accepted; // el prefijo leído pertenece al lenguaje
+    bool viable;   // el prefijo leído se puede completar a una cadena del lenguaje
+};
+
+/**
+ * @class OnlineRecognizer
+ * @brief Reconocedor incremental para gramáticas en FNC.
+ *
+ * Cada Push() calcula una columna nueva: e celdas, y en cada una una
+ * intersección de filas por regla binaria. En cuanto un prefijo deja de ser
+ * viable el reconocedor deja de crecer y rechaza el resto de la entrada.
+ */
+class OnlineRecognizer {
+public:
+    /**
+     * @brief Prepara el reconocedor para el índice dado.
+     * @param index Índice de la gramática en FNC (se copia).
+     */
+    explicit OnlineRecognizer(const CNFIndex& index);
+
+    /**
+     * @brief Añade un carácter a la entrada.
+     * @return si el prefijo leído es aceptado y si es viable.
+     */
+    OnlineStep Push(char c);
+
+    /**
+     * @brief Descarta la entrada leída y vuelve al prefijo vacío.
+     */
+    void Reset();
+
+    /**
+     * @brief Número de caracteres leídos desde el último Reset().
+     */
+    size_t Length() const;
+
+private:
+    CNFIndex index_;
+    size_t nts_;      // número de no terminales
+    size_t nt_words_; // palabras de 64 bits por conjunto de no terminales
+    std::vector<std::vector<int>> unary_by_char_; // byte -> {A | A -> byte}
+    // closure_[B]: no terminales A con A =>* B X1 ... Xm y cada Xi productivo
+    std::vector<uint64_t> closure_;
+
+    size_t n_ = 0;     // caracteres leídos
+    bool dead_ = false; // el prefijo leído ya no es viable
+    size_t words_ = 0; // palabras por fila de posiciones finales
+    // rows_[i][A * words_ + w]: bits k tales que A =>* w[i..k)
+    std::vector<std::vector<uint64_t>> rows_;
+    // Columna en construcción: bits i de T_A(i, e) y de "w[i..e) es prefijo de A"
+    std::vector<uint64_t> col_t_, col_pre_;
+
+    uint64_t* Row(int a, size_t i) { return &rows_[i][a * words_]; }
+    void GrowRows();
+};
+
+#endif
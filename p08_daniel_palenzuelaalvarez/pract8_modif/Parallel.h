@@ -0,0 +1,161 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Parallel.h: Utilidades mínimas de paralelismo basadas en std::thread.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Parallel.h
+ * @brief Reparto de bucles y de grafos de tareas entre hilos.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Número de hilos por defecto (núcleos disponibles, al menos 1).
+ */
+inline unsigned DefaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * @brief Ejecuta f(i) para cada i en [begin, end) repartiendo el trabajo entre hilos.
+ *
+ * Los índices se reparten dinámicamente en bloques de tamaño grain, de modo
+ * que iteraciones de coste desigual no dejan hilos ociosos. El hilo llamante
+ * también trabaja. Si alguna iteración lanza una excepción, se relanza la
+ * primera capturada cuando terminan todos los hilos.
+ *
+ * @param begin Primer índice.
+ * @param end Índice final (excluido).
+ * @param threads Número de hilos a usar (0 equivale a 1).
+ * @param f Función a invocar con cada índice.
+ * @param grain Número de índices que toma cada hilo de una vez.
+ */
+template <class F>
+void ParallelFor(size_t begin, size_t end, unsigned threads, F f, size_t grain = 1) {
+    if (end <= begin) return;
+    if (grain == 0) grain = 1;
+    size_t blocks = (end - begin + grain - 1) / grain;
+    if (threads <= 1 || blocks <= 1) {
+        for (size_t i = begin; i < end; ++i) f(i);
+        return;
+    }
+    if (threads > blocks) threads = static_cast<unsigned>(blocks);
+
+    std::atomic<size_t> next(begin);
+    std::vector<std::exception_ptr> errors(threads);
+    auto worker = [&](unsigned t) {
+        try {
+            for (;;) {
+                size_t lo = next.fetch_add(grain);
+                if (lo >= end) break;
+                size_t hi = lo + grain < end ? lo + grain : end;
+                for (size_t i = lo; i < hi; ++i) f(i);
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+/**
+ * @brief Ejecuta f(v) para cada tarea v de un grafo acíclico de dependencias,
+ *        cada una después de todas aquellas de las que depende.
+ *
+ * Las tareas listas esperan en una pila común protegida por un mutex; al
+ * terminar una tarea se liberan las que solo dependían ya de ella. El hilo
+ * llamante también trabaja. Lo que escribe una tarea es visible para las que
+ * dependen de ella. Si alguna tarea lanza una excepción, no se lanzan más y
+ * se relanza la primera cuando terminan las que estaban en curso.
+ *
+ * @param deps deps[v] son las tareas que deben terminar antes de empezar v.
+ * @param threads Número de hilos a usar (0 equivale a 1).
+ * @param f Función a invocar con cada tarea (int).
+ * @throws std::invalid_argument Si las dependencias tienen un ciclo.
+ */
+template <class F>
+void ParallelDag(const std::vector<std::vector<int>>& deps, unsigned threads, F f) {
+    const size_t n = deps.size();
+    std::vector<std::vector<int>> users(n);
+    std::vector<size_t> remaining(n);
+    std::vector<int> ready;
+    for (size_t v = 0; v < n; ++v) {
+        remaining[v] = deps[v].size();
+        for (int d : deps[v]) users[d].push_back(static_cast<int>(v));
+        if (remaining[v] == 0) ready.push_back(static_cast<int>(v));
+    }
+    if (threads > n) threads = static_cast<unsigned>(n);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t running = 0, done = 0;
+    std::exception_ptr error;
+    auto worker = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            changed.wait(lock, [&] { return !ready.empty() || running == 0 || error; });
+            if (error || ready.empty()) break; // sin tareas listas ni en curso
+            int v = ready.back();
+            ready.pop_back();
+            ++running;
+            lock.unlock();
+            std::exception_ptr e;
+            try {
+                f(v);
+            } catch (...) {
+                e = std::current_exception();
+            }
+            lock.lock();
+            --running;
+            ++done;
+            if (e) {
+                if (!error) error = e;
+            } else {
+                for (int u : users[v]) {
+                    if (--remaining[u] == 0) ready.push_back(u);
+                }
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+    if (error) std::rethrow_exception(error);
+    if (done != n) throw std::invalid_argument("ParallelDag: las dependencias tienen un ciclo");
+}
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: ParseForest.cc: Implementación del bosque de análisis (SPPF).
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file ParseForest.cc
+ * @brief Implementación de ParseForest.
+ */
+
+#include "ParseForest.h"
+
+#include <deque>
+
+/**
+ * @brief Concatena una RHS para mostrarla (igual que en el fichero .gra).
+ */
+static std::string JoinRhs(const std::vector<std::string>& rhs, size_t from, size_t to) {
+    std::string out;
+    for (size_t i = from; i < to; ++i) out += rhs[i];
+    return out;
+}
+
+std::string ParseForest::SourceKey(const std::string& lhs, const std::vector<std::string>& rhs) {
+    std::string key = lhs;
+    for (const auto& tok : rhs) {
+        key += '\0';
+        key += tok;
+    }
+    return key;
+}
+
+/**
+ * @brief Precalcula, por id de símbolo, si es un Ca o un Dk, y un índice
+ *        (lhs, rhs) -> producción original.
+ *
+ * Si hay producciones originales repetidas se conserva la primera, igual
+ * que haría una búsqueda lineal.
+ */
+void ParseForest::IndexGrammar(const Grammar& g) {
+    const int n = index_.NumNonTerminals();
+    is_terminal_.assign(n, 0);
+    for (const auto& entry : g.TerminalNonTerminals()) {
+        int id = index_.IdOf(entry.second);
+        if (id >= 0) is_terminal_[id] = 1;
+    }
+    origin_.assign(n, {-1, -1});
+    for (int id = 0; id < n; ++id) {
+        size_t prod = 0, pos = 0;
+        if (g.AuxiliaryOrigin(index_.Name(id), prod, pos))
+            origin_[id] = {static_cast<long>(prod), static_cast<long>(pos)};
+    }
+    const auto& source = g.SourceProductions();
+    source_index_.clear();
+    source_index_.reserve(source.size());
+    for (size_t i = 0; i < source.size(); ++i)
+        source_index_.emplace(SourceKey(source[i].lhs, source[i].rhs), static_cast<long>(i));
+}
+
+int32_t ParseForest::GetOrCreate(int symbol, uint32_t begin, uint32_t end, bool& created) {
+    NodeKey key{symbol, begin, end};
+    auto it = lookup_.find(key);
+    if (it != lookup_.end()) {
+        created = false;
+        return it->second;
+    }
+    int32_t id = static_cast<int32_t>(nodes_.size());
+    nodes_.push_back(ForestNode{symbol, begin, end, 0, 0});
+    lookup_.emplace(key, id);
+    created = true;
+    return id;
+}
+
+/**
+ * @brief Recorre la tabla CYK desde la raíz y crea nodos y alternativas.
+ *
+ * Cada nodo se expande una única vez (cuando se crea); sus alternativas se
+ * añaden de forma contigua a la arena de alternativas.
+ */
+ParseForest ParseForest::Build(const CYKRecognizer& cyk, const Grammar& g, const std::string& word) {
+    ParseForest f;
+    f.index_ = cyk.Index();
+    f.word_ = word;
+    f.IndexGrammar(g);
+    const size_t n = word.size();
+    if (n == 0) return f;
+
+    CYKTable table = cyk.Fill(word);
+    const CNFIndex& index = f.index_;
+    if (!table.Has(0, n, index.Start())) return f;
+
+    // Reglas agrupadas por lado izquierdo
+    std::vector<std::vector<int>> binary_by_lhs(index.NumNonTerminals());
+    for (size_t r = 0; r < index.BinaryRules().size(); ++r)
+        binary_by_lhs[index.BinaryRules()[r].lhs].push_back(static_cast<int>(r));
+    std::vector<std::vector<char>> unary_by_lhs(index.NumNonTerminals());
+    for (const auto& r : index.UnaryRules()) unary_by_lhs[r.lhs].push_back(r.terminal);
+
+    bool created = false;
+    f.root_ = f.GetOrCreate(index.Start(), 0, static_cast<uint32_t>(n), created);
+    std::deque<int32_t> pending;
+    pending.push_back(f.root_);
+
+    while (!pending.empty()) {
+        int32_t v = pending.front();
+        pending.pop_front();
+        // Copiar los campos: nodes_ puede crecer mientras se expande v
+        const int a = f.nodes_[v].symbol;
+        const uint32_t begin = f.nodes_[v].begin;
+        const uint32_t len = f.nodes_[v].end - begin;
+        const uint32_t first = static_cast<uint32_t>(f.packed_.size());
+
+        if (len == 1) {
+            for (char t : unary_by_lhs[a]) {
+                if (t == word[begin]) f.packed_.push_back(PackedNode{-1, 0, -1, -1});
+            }
+        } else {
+            for (int r : binary_by_lhs[a]) {
+                const BinaryRule& rule = index.BinaryRules()[r];
+                for (uint32_t k = 1; k < len; ++k) {
+                    if (!table.Has(begin, k, rule.left) || !table.Has(begin + k, len - k, rule.right)) continue;
+                    int32_t l = f.GetOrCreate(rule.left, begin, begin + k, created);
+                    if (created) pending.push_back(l);
+                    int32_t rr = f.GetOrCreate(rule.right, begin + k, begin + len, created);
+                    if (created) pending.push_back(rr);
+                    f.packed_.push_back(PackedNode{r, begin + k, l, rr});
+                }
+            }
+        }
+        f.nodes_[v].first_packed = first;
+        f.nodes_[v].num_packed = static_cast<uint32_t>(f.packed_.size()) - first;
+    }
+    return f;
+}
+
+int ParseForest::Root() const { return root_; }
+
+const std::vector<ForestNode>& ParseForest::Nodes() const { return nodes_; }
+
+const std::vector<PackedNode>& ParseForest::Packed() const { return packed_; }
+
+/**
+ * @brief Relaciona una alternativa con la producción original.
+ *
+ * - Si el nodo es un Dk, la producción es la de la que procede el Dk.
+ * - Si el hijo derecho es el primer Dk de una producción de A, es esa producción.
+ * - En otro caso la regla tiene longitud 1 o 2 y se busca en source_index_ la producción
+ *   original con la misma RHS (deshaciendo los Ca).
+ */
+long ParseForest::SourceProduction(const Grammar& g, int node, uint32_t packed) const {
+    const ForestNode& nd = nodes_[node];
+    const PackedNode& pk = packed_[nd.first_packed + packed];
+    const std::string& a = index_.Name(nd.symbol);
+
+    if (origin_[nd.symbol].first >= 0) return origin_[nd.symbol].first;
+
+    std::vector<std::string> rhs;
+    if (pk.rule < 0) {
+        rhs.push_back(std::string(1, word_[nd.begin]));
+    } else {
+        const BinaryRule& rule = index_.BinaryRules()[pk.rule];
+        long prod = origin_[rule.right].first;
+        if (prod >= 0 && origin_[rule.right].second == 1 && g.SourceProductions()[prod].lhs == a) return prod;
+        for (int32_t child : {pk.left, pk.right}) {
+            // Un Ca se deshace con el carácter que cubre (puede representar una clase)
+            const int symbol = nodes_[child].symbol;
+            rhs.push_back(is_terminal_[symbol] ? std::string(1, word_[nodes_[child].begin]) : index_.Name(symbol));
+        }
+    }
+    auto it = source_index_.find(SourceKey(a, rhs));
+    return it == source_index_.end() ? -1 : it->second;
+}
+
+std::string ParseForest::Label(const Grammar& g, int32_t node) const {
+    const ForestNode& nd = nodes_[node];
+    const std::string& name = index_.Name(nd.symbol);
+    std::string span = "(" + std::to_string(nd.begin) + "," + std::to_string(nd.end) + ")";
+    if (is_terminal_[nd.symbol]) return std::string("'") + word_[nd.begin] + "'" + span;
+    if (origin_[nd.symbol].first >= 0) {
+        // Nodo intermedio: A -> alfa . beta, donde beta es lo que genera el Dk
+        const Production& p = g.SourceProductions()[origin_[nd.symbol].first];
+        const size_t pos = static_cast<size_t>(origin_[nd.symbol].second);
+        return "<" + p.lhs + " -> " + JoinRhs(p.rhs, 0, pos) + " . " + JoinRhs(p.rhs, pos, p.rhs.size()) + ">" + span;
+    }
+    return name + span;
+}
+
+/**
+ * @brief Escribe cada nodo (salvo los Ca, que se muestran como terminales)
+ *        seguido de sus alternativas.
+ */
+void ParseForest::Print(std::ostream& os, const Grammar& g) const {
+    os << "SPPF de \"" << word_ << "\": " << nodes_.size() << " nodos, "
+       << packed_.size() << " alternativas\n";
+    if (root_ < 0) {
+        os << "La cadena no pertenece al lenguaje.\n";
+        return;
+    }
+    for (size_t v = 0; v < nodes_.size(); ++v) {
+        if (is_terminal_[nodes_[v].symbol]) continue;
+        os << Label(g, static_cast<int32_t>(v)) << "\n";
+        for (uint32_t p = 0; p < nodes_[v].num_packed; ++p) {
+            const PackedNode& pk = packed_[nodes_[v].first_packed + p];
+            long src = SourceProduction(g, static_cast<int>(v), p);
+            os << "  | ";
+            if (src >= 0) {
+                const Production& sp = g.SourceProductions()[src];
+                os << sp.lhs << " -> " << JoinRhs(sp.rhs, 0, sp.rhs.size());
+            } else {
+                os << index_.Name(nodes_[v].symbol) << " -> ?";
+            }
+            os << " :";
+            if (pk.rule < 0) {
+                os << " '" << word_[nodes_[v].begin] << "'";
+            } else {
+                os << " " << Label(g, pk.left) << " " << Label(g, pk.right);
+            }
+            os << "\n";
+        }
+    }
+}
@@ -0,0 +1,179 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: ParseForest.h: Bosque de análisis compartido y empaquetado (SPPF)
+ *    construido a partir de la tabla CYK.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file ParseForest.h
+ * @brief SPPF de una cadena para una gramática en FNC.
+ *
+ * Cada nodo de símbolo (A, i, j) aparece una sola vez (se deduplica con una
+ * tabla hash) y agrupa todas sus alternativas como nodos empaquetados. Los
+ * nodos y las alternativas se guardan en vectores contiguos (arena) y se
+ * referencian por índice, de modo que el bosque ocupa O(n^2 |N|) nodos y
+ * O(n^3 |G|) alternativas aunque el número de árboles sea exponencial.
+ *
+ * Al imprimir, los auxiliares Dk se muestran como nodos intermedios de la
+ * producción original de la que proceden y los Ca como el terminal que
+ * representan, de forma que el bosque se lee sobre la gramática de entrada.
+ * Las tablas para deshacer la conversión (qué símbolos son Ca o Dk y qué
+ * producción original tiene cada (lhs, rhs)) se construyen una sola vez al
+ * crear el bosque, no en cada alternativa impresa.
+ */
+
+#ifndef PARSE_FOREST_H
+#define PARSE_FOREST_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CYK.h"
+#include "Grammar2CNF.h"
+
+/**
+ * @brief Alternativa de un nodo de símbolo.
+ *
+ * rule es el índice de la regla binaria A -> BC usada (con corte en split e
+ * hijos left y right), o -1 si la alternativa es una regla unaria A -> a.
+ */
+struct PackedNode {
+    int rule;       // índice en CNFIndex::BinaryRules(), o -1 si es unaria
+    uint32_t split; // posición de corte (solo reglas binarias)
+    int32_t left;   // índice del hijo izquierdo (o -1)
+    int32_t right;  // índice del hijo derecho (o -1)
+};
+
+/**
+ * @brief Nodo de símbolo (A, begin, end): A genera word[begin, end).
+ */
+struct ForestNode {
+    int symbol;            // id del no terminal
+    uint32_t begin;        // posición inicial
+    uint32_t end;          // posición final (excluida)
+    uint32_t first_packed; // primera alternativa en la arena de alternativas
+    uint32_t num_packed;   // número de alternativas
+};
+
+/**
+ * @class ParseForest
+ * @brief SPPF de una cadena, con raíz en (S, 0, n) si la cadena es aceptada.
+ */
+class ParseForest {
+public:
+    /**
+     * @brief Construye el bosque de la cadena a partir de la tabla CYK.
+     *
+     * Solo se crean los nodos alcanzables desde la raíz, es decir, los que
+     * participan en alguna derivación completa de la cadena.
+     *
+     * @param cyk Reconocedor CYK de la gramática en FNC.
+     * @param g Gramática convertida con TransformToCNF() de la que procede cyk.
+     * @param word Cadena de entrada.
+     */
+    static ParseForest Build(const CYKRecognizer& cyk, const Grammar& g, const std::string& word);
+
+    /**
+     * @brief Índice del nodo raíz, o -1 si la cadena no es aceptada.
+     */
+    int Root() const;
+
+    /**
+     * @brief Nodos de símbolo del bosque.
+     */
+    const std::vector<ForestNode>& Nodes() const;
+
+    /**
+     * @brief Alternativas (nodos empaquetados) del bosque.
+     */
+    const std::vector<PackedNode>& Packed() const;
+
+    /**
+     * @brief Índice de la producción original de la que procede una alternativa.
+     * @param g La misma gramática que se pasó a Build().
+     * @param node Índice del nodo de símbolo.
+     * @param packed Índice de la alternativa.
+     * @return índice en g.SourceProductions(), o -1 si no se puede determinar.
+     */
+    long SourceProduction(const Grammar& g, int node, uint32_t packed) const;
+
+    /**
+     * @brief Escribe el bosque sobre la gramática original, un nodo por bloque.
+     * @param os Flujo de salida.
+     * @param g La misma gramática que se pasó a Build().
+     */
+    void Print(std::ostream& os, const Grammar& g) const;
+
+private:
+    /**
+     * @brief Clave (símbolo, inicio, fin) para deduplicar nodos.
+     */
+    struct NodeKey {
+        int symbol;
+        uint32_t begin;
+        uint32_t end;
+        bool operator==(const NodeKey& o) const {
+            return symbol == o.symbol && begin == o.begin && end == o.end;
+        }
+    };
+
+    /**
+     * @brief Función hash para NodeKey.
+     */
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& k) const {
+            uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(k.symbol)) * 0x9E3779B97F4A7C15ULL;
+            h ^= (static_cast<uint64_t>(k.begin) << 32 | k.end) + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    CNFIndex index_;                  // índice de la gramática (nombres y reglas)
+    std::string word_;                // cadena analizada
+    int root_ = -1;                   // nodo raíz
+    std::vector<ForestNode> nodes_;   // arena de nodos de símbolo
+    std::vector<PackedNode> packed_;  // arena de alternativas
+    std::unordered_map<NodeKey, int32_t, NodeKeyHash> lookup_; // (A, i, j) -> nodo
+    std::vector<char> is_terminal_;   // símbolo -> es un Ca
+    std::vector<std::pair<long, long>> origin_; // símbolo -> (producción, posición) si es un Dk, o (-1, -1)
+    std::unordered_map<std::string, long> source_index_; // clave (lhs, rhs) -> producción original
+
+    /**
+     * @brief Clave de source_index_ para una producción (lhs, rhs).
+     */
+    static std::string SourceKey(const std::string& lhs, const std::vector<std::string>& rhs);
+
+    /**
+     * @brief Rellena is_terminal_, origin_ y source_index_ a partir de g.
+     */
+    void IndexGrammar(const Grammar& g);
+
+    /**
+     * @brief Devuelve el nodo (symbol, begin, end), creándolo si no existe.
+     * @param created Se pone a true si el nodo se acaba de crear.
+     */
+    int32_t GetOrCreate(int symbol, uint32_t begin, uint32_t end, bool& created);
+
+    /**
+     * @brief Etiqueta legible de un nodo sobre la gramática original.
+     */
+    std::string Label(const Grammar& g, int32_t node) const;
+};
+
+#endif
@@ -0,0 +1,402 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Regular.cc: Implementación de la compilación a AFD mínimo.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Regular.cc
+ * @brief Implementación de DFA::FromGrammar.
+ */
+
+#include "Regular.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief AFN con transiciones vacías sobre el alfabeto compacto 0..k-1.
+ */
+struct NFA {
+    std::vector<std::vector<std::pair<int, int>>> moves; // estado -> (símbolo, destino)
+    std::vector<std::vector<int>> empty;                 // estado -> destinos vacíos
+    int start = 0;
+    std::vector<bool> accepting;
+
+    int Add() {
+        moves.emplace_back();
+        empty.emplace_back();
+        accepting.push_back(false);
+        return static_cast<int>(moves.size()) - 1;
+    }
+
+    /**
+     * @brief Cierre por transiciones vacías de un conjunto, ordenado.
+     */
+    std::vector<int> Closure(const std::vector<int>& from) const {
+        std::vector<bool> in(moves.size(), false);
+        std::vector<int> set;
+        for (int s : from) {
+            if (!in[s]) {
+                in[s] = true;
+                set.push_back(s);
+            }
+        }
+        for (size_t i = 0; i < set.size(); ++i) {
+            for (int t : empty[set[i]]) {
+                if (!in[t]) {
+                    in[t] = true;
+                    set.push_back(t);
+                }
+            }
+        }
+        std::sort(set.begin(), set.end());
+        return set;
+    }
+};
+
+/**
+ * @brief Construye el AFN de un no terminal regular por componentes.
+ *
+ * Una instancia de una componente kRight tiene un estado por miembro y sale
+ * a un estado ancla dado: A -> x1..xm C (C miembro) es un camino de A a C y
+ * A -> x1..xm un camino de A al ancla. Por la izquierda es al revés: el ancla
+ * es la entrada, A -> C x1..xm va de C a A y A -> x1..xm del ancla a A. Un no
+ * terminal B de otra componente dentro de un camino p -> q se sustituye por
+ * una instancia de la suya anclada en q (kRight) o en p (kLeft), enlazada con
+ * una transición vacía. Las instancias se reutilizan por (componente, ancla),
+ * así que una subgramática lineal usa un solo estado por no terminal.
+ */
+class NFABuilder {
+public:
+    NFABuilder(NFA& nfa, const std::vector<std::vector<const Production*>>& rules,
+               const std::function<int(const std::string&)>& id_of, const std::vector<int>& comp,
+               const std::vector<Linearity>& form, const std::vector<int>& symbol)
+        : nfa_(nfa), rules_(rules), id_of_(id_of), comp_(comp), form_(form), symbol_(symbol),
+          members_(comp.empty() ? 0 : *std::max_element(comp.begin(), comp.end()) + 1) {
+        for (size_t a = 0; a < comp.size(); ++a) members_[comp[a]].push_back(static_cast<int>(a));
+    }
+
+    /**
+     * @brief Estados de los miembros de la componente c anclada en anchor
+     *        (índice por no terminal, -1 para los que no son miembros).
+     */
+    const std::vector<int>& Instance(int c, int anchor) {
+        auto key = std::make_pair(c, anchor);
+        auto it = instances_.find(key);
+        if (it != instances_.end()) return it->second;
+        std::vector<int> state(comp_.size(), -1);
+        for (int a : members_[c]) state[a] = nfa_.Add();
+        const bool right = form_[members_[c][0]] == Linearity::kRight;
+        for (int a : members_[c]) {
+            for (const Production* p : rules_[a]) {
+                std::vector<std::string> tokens;
+                if (!p->IsEmpty()) tokens = p->rhs;
+                if (right) {
+                    int last = tokens.empty() ? -1 : id_of_(tokens.back());
+                    if (last >= 0 && comp_[last] == c) {
+                        tokens.pop_back();
+                        Path(state[a], tokens, state[last]);
+                    } else {
+                        Path(state[a], tokens, anchor);
+                    }
+                } else {
+                    int first = tokens.empty() ? -1 : id_of_(tokens.front());
+                    if (first >= 0 && comp_[first] == c) {
+                        tokens.erase(tokens.begin());
+                        Path(state[first], tokens, state[a]);
+                    } else {
+                        Path(anchor, tokens, state[a]);
+                    }
+                }
+            }
+        }
+        if (nfa_.moves.size() > DFA::kMaxStates)
+            throw std::runtime_error("El AFN supera " + std::to_string(DFA::kMaxStates) + " estados.");
+        return instances_.emplace(key, std::move(state)).first->second;
+    }
+
+private:
+    NFA& nfa_;
+    const std::vector<std::vector<const Production*>>& rules_;
+    const std::function<int(const std::string&)>& id_of_;
+    const std::vector<int>& comp_;
+    const std::vector<Linearity>& form_;
+    const std::vector<int>& symbol_;
+    std::vector<std::vector<int>> members_; // componente -> no terminales
+    std::map<std::pair<int, int>, std::vector<int>> instances_;
+
+    /**
+     * @brief Camino from -> to que reconoce la secuencia de símbolos (una
+     *        transición vacía si está vacía), con estados intermedios nuevos.
+     */
+    void Path(int from, const std::vector<std::string>& tokens, int to) {
+        if (tokens.empty()) {
+            nfa_.empty[from].push_back(to);
+            return;
+        }
+        int cur = from;
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            const int next = i + 1 == tokens.size() ? to : nfa_.Add();
+            const int b = id_of_(tokens[i]);
+            if (b < 0) {
+                nfa_.moves[cur].emplace_back(symbol_[static_cast<unsigned char>(tokens[i][0])], next);
+            } else if (form_[b] == Linearity::kRight) {
+                // Instance() añade estados: no se puede tener ya una referencia a empty[cur]
+                const int entry = Instance(comp_[b], next)[b];
+                nfa_.empty[cur].push_back(entry);
+            } else {
+                const int exit = Instance(comp_[b], cur)[b];
+                nfa_.empty[exit].push_back(next);
+            }
+            cur = next;
+        }
+    }
+};
+
+/**
+ * @brief Minimización de Hopcroft de un AFD completo con k símbolos.
+ *
+ * Los bloques de la partición ocupan tramos contiguos de elems; al marcar un
+ * estado se mueve al principio del tramo de su bloque, de modo que dividir
+ * un bloque es partir su tramo en dos.
+ *
+ * @param delta Transiciones [estado * k + símbolo].
+ * @param accepting Estados de aceptación.
+ * @param block_of Bloque de cada estado (salida).
+ * @return número de bloques.
+ */
+size_t Minimize(const std::vector<int>& delta, const std::vector<bool>& accepting, size_t k,
+                std::vector<int>& block_of) {
+    const size_t n = accepting.size();
+    // Predecesores por símbolo, en formato CSR: pred[pred_start[t * k + a] ...]
+    std::vector<int> pred_start(n * k + 1, 0), pred(n * k);
+    for (size_t s = 0; s < n; ++s) {
+        for (size_t a = 0; a < k; ++a) ++pred_start[delta[s * k + a] * k + a + 1];
+    }
+    for (size_t i = 0; i < n * k; ++i) pred_start[i + 1] += pred_start[i];
+    {
+        std::vector<int> fill(pred_start.begin(), pred_start.end() - 1);
+        for (size_t s = 0; s < n; ++s) {
+            for (size_t a = 0; a < k; ++a) pred[fill[delta[s * k + a] * k + a]++] = static_cast<int>(s);
+        }
+    }
+
+    std::vector<int> elems(n), loc(n), first, end, marked;
+    block_of.assign(n, 0);
+    // Partición inicial: aceptación / no aceptación
+    size_t pos = 0;
+    for (bool acc : {false, true}) {
+        size_t begin = pos;
+        for (size_t s = 0; s < n; ++s) {
+            if (accepting[s] != acc) continue;
+            elems[pos] = static_cast<int>(s);
+            loc[s] = static_cast<int>(pos++);
+            block_of[s] = static_cast<int>(first.size());
+        }
+        if (pos == begin) continue;
+        first.push_back(static_cast<int>(begin));
+        end.push_back(static_cast<int>(pos));
+        marked.push_back(0);
+    }
+
+    std::vector<std::pair<int, int>> work; // (bloque, símbolo)
+    std::vector<std::vector<bool>> in_work(first.size(), std::vector<bool>(k, false));
+    const int smaller = first.size() == 2 && end[1] - first[1] < end[0] - first[0] ? 1 : 0;
+    for (size_t a = 0; a < k; ++a) {
+        work.emplace_back(smaller, static_cast<int>(a));
+        in_work[smaller][a] = true;
+    }
+
+    std::vector<int> splitter, touched;
+    while (!work.empty()) {
+        const int b = work.back().first, a = work.back().second;
+        work.pop_back();
+        in_work[b][a] = false;
+        splitter.assign(elems.begin() + first[b], elems.begin() + end[b]);
+
+        for (int t : splitter) {
+            for (int i = pred_start[t * k + a]; i < pred_start[t * k + a + 1]; ++i) {
+                const int p = pred[i], x = block_of[p];
+                const int j = first[x] + marked[x];
+                if (loc[p] < j) continue; // ya marcado
+                std::swap(elems[loc[p]], elems[j]);
+                loc[elems[loc[p]]] = loc[p];
+                loc[p] = j;
+                if (marked[x]++ == 0) touched.push_back(x);
+            }
+        }
+
+        for (int x : touched) {
+            const int m = marked[x];
+            marked[x] = 0;
+            if (m == end[x] - first[x]) continue;
+            const int y = static_cast<int>(first.size());
+            first.push_back(first[x]);
+            end.push_back(first[x] + m);
+            marked.push_back(0);
+            first[x] += m;
+            for (int i = first[y]; i < end[y]; ++i) block_of[elems[i]] = y;
+            in_work.emplace_back(k, false);
+            for (size_t c = 0; c < k; ++c) {
+                int add = in_work[x][c] || end[y] - first[y] < end[x] - first[x] ? y : x;
+                if (!in_work[add][c]) {
+                    work.emplace_back(add, static_cast<int>(c));
+                    in_work[add][c] = true;
+                }
+            }
+        }
+        touched.clear();
+    }
+    return first.size();
+}
+
+} // namespace
+
+/**
+ * @brief AFN (ver NFABuilder), construcción de subconjuntos, Hopcroft y
+ *        tabla de 256 columnas. Si la componente de start es kRight se
+ *        empieza en start y se acepta en un estado final nuevo; si es kLeft
+ *        se empieza en un estado nuevo y se acepta en start.
+ */
+DFA DFA::FromGrammar(const Grammar& g, const std::string& start) {
+    const std::vector<std::string> names(g.NonTerminals().begin(), g.NonTerminals().end());
+    const std::function<int(const std::string&)> id_of = [&](const std::string& name) {
+        auto it = std::lower_bound(names.begin(), names.end(), name);
+        return it != names.end() && *it == name ? static_cast<int>(it - names.begin()) : -1;
+    };
+    const int start_id = id_of(start);
+    if (start_id < 0) throw std::runtime_error("No terminal desconocido: '" + start + "'.");
+    std::vector<int> comp;
+    const std::vector<Linearity> form = g.RegularNonTerminals(&comp);
+    if (form[start_id] == Linearity::kNone) throw std::runtime_error("El lenguaje de " + start + " no es regular.");
+
+    // Reglas de los no terminales alcanzables desde start
+    std::vector<std::vector<const Production*>> rules(names.size());
+    for (const auto& p : g.Productions()) rules[id_of(p.lhs)].push_back(&p);
+    std::vector<bool> reached(names.size(), false);
+    std::vector<int> order{start_id};
+    reached[start_id] = true;
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (const Production* p : rules[order[i]]) {
+            for (const auto& tok : p->rhs) {
+                int b = id_of(tok);
+                if (b >= 0 && !reached[b]) {
+                    reached[b] = true;
+                    order.push_back(b);
+                }
+            }
+        }
+    }
+
+    // Alfabeto compacto: solo los terminales que aparecen en esas reglas
+    std::vector<int> symbol(256, -1);
+    std::vector<unsigned char> bytes;
+    for (int a : order) {
+        for (const Production* p : rules[a]) {
+            if (p->IsEmpty()) continue;
+            for (const auto& tok : p->rhs) {
+                unsigned char c = static_cast<unsigned char>(tok[0]);
+                if (id_of(tok) >= 0 || symbol[c] >= 0) continue;
+                symbol[c] = static_cast<int>(bytes.size());
+                bytes.push_back(c);
+            }
+        }
+    }
+    const size_t k = bytes.size();
+
+    NFA nfa;
+    NFABuilder builder(nfa, rules, id_of, comp, form, symbol);
+    const int extra = nfa.Add(); // final (kRight) o inicial (kLeft)
+    const std::vector<int>& inst = builder.Instance(comp[start_id], extra);
+    nfa.start = form[start_id] == Linearity::kRight ? inst[start_id] : extra;
+    nfa.accepting[form[start_id] == Linearity::kRight ? extra : inst[start_id]] = true;
+
+    // Construcción de subconjuntos; el conjunto vacío es el estado 0
+    std::map<std::vector<int>, int> ids;
+    std::vector<std::vector<int>> sets{{}};
+    ids[{}] = 0;
+    sets.push_back(nfa.Closure({nfa.start}));
+    ids[sets[1]] = 1;
+    std::vector<int> delta;
+    std::vector<std::vector<int>> targets(k);
+    for (size_t d = 0; d < sets.size(); ++d) {
+        for (auto& t : targets) t.clear();
+        for (int s : sets[d]) {
+            for (const auto& mv : nfa.moves[s]) targets[mv.first].push_back(mv.second);
+        }
+        for (size_t a = 0; a < k; ++a) {
+            std::vector<int> next = nfa.Closure(targets[a]);
+            auto it = ids.find(next);
+            if (it == ids.end()) {
+                if (sets.size() >= kMaxStates)
+                    throw std::runtime_error("El AFD de " + start + " supera " + std::to_string(kMaxStates) + " estados.");
+                it = ids.emplace(next, static_cast<int>(sets.size())).first;
+                sets.push_back(std::move(next));
+            }
+            delta.push_back(it->second);
+        }
+    }
+    std::vector<bool> accepting(sets.size(), false);
+    for (size_t d = 0; d < sets.size(); ++d) {
+        for (int s : sets[d]) {
+            if (nfa.accepting[s]) accepting[d] = true;
+        }
+    }
+
+    std::vector<int> block_of;
+    const size_t blocks = Minimize(delta, accepting, k, block_of);
+
+    // Numeración final: el bloque del conjunto vacío es el 0 y el resto se
+    // numera en orden de recorrido desde el inicial
+    DFA dfa;
+    std::vector<int32_t> number(blocks, -1);
+    std::vector<int> rep(blocks, -1); // estado representante de cada bloque
+    for (size_t d = 0; d < sets.size(); ++d) {
+        if (rep[block_of[d]] < 0) rep[block_of[d]] = static_cast<int>(d);
+    }
+    number[block_of[0]] = 0;
+    std::vector<int> queue{block_of[0], block_of[1]};
+    if (block_of[1] != block_of[0]) number[block_of[1]] = 1;
+    int32_t next_number = number[block_of[1]] + 1;
+    for (size_t i = 1; i < queue.size(); ++i) {
+        for (size_t a = 0; a < k; ++a) {
+            int to = block_of[delta[rep[queue[i]] * k + a]];
+            if (number[to] < 0) {
+                number[to] = next_number++;
+                queue.push_back(to);
+            }
+        }
+    }
+    dfa.delta_.assign(static_cast<size_t>(next_number) * 256, 0);
+    dfa.accepting_.assign(next_number, 0);
+    for (int b : queue) {
+        const int32_t s = number[b];
+        if (s == 0) continue;
+        dfa.accepting_[s] = accepting[rep[b]];
+        for (size_t a = 0; a < k; ++a) {
+            dfa.delta_[static_cast<size_t>(s) * 256 + bytes[a]] = number[block_of[delta[rep[b] * k + a]]];
+        }
+    }
+    dfa.start_ = number[block_of[1]];
+    dfa.stats_.nfa_states = nfa.moves.size();
+    dfa.stats_.dfa_states = sets.size();
+    dfa.stats_.min_states = dfa.accepting_.size();
+    return dfa;
+}
@@ -0,0 +1,117 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Regular.h: Compilación de gramáticas lineales a autómatas finitos.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+ *    J. Hopcroft. An n log n Algorithm for Minimizing States in a Finite
+ *    Automaton. 1971.
+*/
+
+/**
+ * @file Regular.h
+ * @brief AFD mínimo equivalente a un no terminal que genera un lenguaje regular.
+ *
+ * La subgramática se traduce a un AFN con transiciones vacías (un estado por
+ * no terminal de cada componente y estados intermedios para las reglas con
+ * varios símbolos), se determiniza por construcción de subconjuntos y se
+ * minimiza con el algoritmo de Hopcroft. La tabla final tiene una fila de 256 entradas por
+ * estado, de modo que reconocer es un bucle de un acceso por carácter.
+ */
+
+#ifndef REGULAR_H
+#define REGULAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Grammar2CNF.h"
+
+/**
+ * @brief Número de estados de cada etapa de la compilación.
+ */
+struct DFAStats {
+    size_t nfa_states = 0;
+    size_t dfa_states = 0; // tras la construcción de subconjuntos
+    size_t min_states = 0; // tras minimizar (incluido el estado de error)
+};
+
+/**
+ * @class DFA
+ * @brief Autómata finito determinista completo sobre bytes.
+ *
+ * El estado 0 es el de error: no es de aceptación y todas sus transiciones
+ * vuelven a él.
+ */
+class DFA {
+public:
+    /**
+     * @brief Compila el lenguaje del no terminal start.
+     * @param g Gramática (antes de TransformToCNF()).
+     * @param start No terminal regular (ver Grammar::RegularNonTerminals()).
+     * @throws std::runtime_error Si el lenguaje no es regular o el AFN o el
+     *         AFD superan kMaxStates estados.
+     */
+    static DFA FromGrammar(const Grammar& g, const std::string& start);
+
+    /**
+     * @brief Límite de estados del AFN y de la construcción de subconjuntos.
+     */
+    static const size_t kMaxStates = 1 << 16;
+
+    /**
+     * @brief Decide si la cadena pertenece al lenguaje.
+     */
+    bool Accepts(const std::string& word) const {
+        int32_t s = start_;
+        for (unsigned char c : word) {
+            s = delta_[static_cast<size_t>(s) * 256 + c];
+            if (s == 0) return false;
+        }
+        return accepting_[s] != 0;
+    }
+
+    /**
+     * @brief Estado inicial.
+     */
+    int32_t Start() const { return start_; }
+
+    /**
+     * @brief Transición desde el estado s con el byte c.
+     */
+    int32_t Next(int32_t s, unsigned char c) const { return delta_[static_cast<size_t>(s) * 256 + c]; }
+
+    /**
+     * @brief Indica si el estado s es de aceptación.
+     */
+    bool Accepting(int32_t s) const { return accepting_[s] != 0; }
+
+    /**
+     * @brief Número de estados del AFD mínimo.
+     */
+    size_t NumStates() const { return accepting_.size(); }
+
+    /**
+     * @brief Tamaño de cada etapa de la compilación.
+     */
+    const DFAStats& Stats() const { return stats_; }
+
+private:
+    std::vector<int32_t> delta_;     // [estado * 256 + byte]
+    std::vector<uint8_t> accepting_; // [estado]
+    int32_t start_ = 0;
+    DFAStats stats_;
+};
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Sampler.cc: Implementación del muestreo uniforme de cadenas.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Sampler.cc
+ * @brief Implementación de UniformSampler.
+ */
+
+#include "Sampler.h"
+
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Devuelve un entero uniforme en [0, bound) (bound > 0) por rechazo.
+ */
+static BigUnsigned RandomBelow(const BigUnsigned& bound, std::mt19937_64& rng) {
+    const size_t bits = bound.BitLength();
+    const size_t limbs = (bits + 31) / 32;
+    const uint32_t top_mask = bits % 32 == 0 ? 0xffffffffu : ((uint32_t(1) << (bits % 32)) - 1);
+    // Con la máscara de la palabra alta, cada intento acierta con probabilidad > 1/2
+    for (;;) {
+        std::vector<uint32_t> v(limbs);
+        for (auto& w : v) w = static_cast<uint32_t>(rng());
+        v.back() &= top_mask;
+        BigUnsigned r = BigUnsigned::FromLimbs(std::move(v));
+        if (r < bound) return r;
+    }
+}
+
+UniformSampler::UniformSampler(const CNFIndex& index, size_t max_len, unsigned threads)
+    : index_(index),
+      counter_(index, max_len, threads),
+      binary_by_lhs_(index.NumNonTerminals()),
+      unary_by_lhs_(index.NumNonTerminals()) {
+    for (const auto& r : index_.BinaryRules()) binary_by_lhs_[r.lhs].push_back(r);
+    for (const auto& r : index_.UnaryRules()) unary_by_lhs_[r.lhs].push_back(r.terminal);
+}
+
+/**
+ * @brief Expande el símbolo de arranque con longitud len eligiendo cada paso
+ *        con probabilidad proporcional al número de derivaciones.
+ */
+std::string UniformSampler::Sample(size_t len, std::mt19937_64& rng) const {
+    if (len == 0 || len > counter_.MaxLength() || counter_.Count(index_.Start(), len).IsZero())
+        throw std::runtime_error("No existe ninguna cadena de longitud " + std::to_string(len) + ".");
+
+    std::string out;
+    out.reserve(len);
+    // Pila de (no terminal, longitud); se expande primero el hijo izquierdo
+    std::vector<std::pair<int, size_t>> stack;
+    stack.emplace_back(index_.Start(), len);
+    while (!stack.empty()) {
+        auto [a, l] = stack.back();
+        stack.pop_back();
+
+        if (l == 1) {
+            // Todas las reglas A -> a aportan una derivación
+            const auto& terms = unary_by_lhs_[a];
+            std::uniform_int_distribution<size_t> pick(0, terms.size() - 1);
+            out.push_back(terms[pick(rng)]);
+            continue;
+        }
+
+        BigUnsigned r = RandomBelow(counter_.Count(a, l), rng);
+        bool chosen = false;
+        // Cortes en orden alternado (1, l-1, 2, l-2, ...) y, en cada corte, las
+        // reglas: se para en el primer corte donde cae r, sin recorrer los
+        // demás cortes de las reglas anteriores
+        for (size_t lo = 1, hi = l - 1; lo <= hi && !chosen; ++lo, --hi) {
+            for (size_t k : {lo, hi}) {
+                for (const auto& rule : binary_by_lhs_[a]) {
+                    BigUnsigned w = counter_.Count(rule.left, k) * counter_.Count(rule.right, l - k);
+                    if (r < w) {
+                        stack.emplace_back(rule.right, l - k);
+                        stack.emplace_back(rule.left, k);
+                        chosen = true;
+                        break;
+                    }
+                    r -= w;
+                }
+                if (chosen || lo == hi) break; // corte central: no repetirlo
+            }
+        }
+        if (!chosen) throw std::logic_error("UniformSampler: cuentas inconsistentes.");
+    }
+    return out;
+}
+
+void UniformSampler::WriteSamples(const std::string& path, size_t count, size_t len,
+                                  unsigned threads, uint64_t seed) const {
+    if (len == 0 || len > counter_.MaxLength() || counter_.Count(index_.Start(), len).IsZero())
+        throw std::runtime_error("No existe ninguna cadena de longitud " + std::to_string(len) + ".");
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("No se pudo crear el fichero de salida: " + path);
+    // Búfer grande: las escrituras se hacen por bloques completos de líneas
+    std::setvbuf(f, nullptr, _IOFBF, 1 << 20);
+
+    if (threads == 0) threads = 1;
+    if (threads > count && count > 0) threads = static_cast<unsigned>(count);
+    const size_t kFlushBytes = 1 << 16;
+
+    std::mutex out_mutex;
+    bool write_error = false;
+    auto flush = [&](std::string& buf) {
+        std::lock_guard<std::mutex> lock(out_mutex);
+        if (std::fwrite(buf.data(), 1, buf.size(), f) != buf.size()) write_error = true;
+        buf.clear();
+    };
+
+    std::vector<std::exception_ptr> errors(threads);
+    auto worker = [&](unsigned t) {
+        try {
+            // Semilla independiente por hilo
+            std::seed_seq seq{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32), t};
+            std::mt19937_64 rng(seq);
+            size_t mine = count / threads + (t < count % threads ? 1 : 0);
+            std::string buf;
+            buf.reserve(kFlushBytes + len + 1);
+            for (size_t i = 0; i < mine; ++i) {
+                buf += Sample(len, rng);
+                buf.push_back('\n');
+                if (buf.size() >= kFlushBytes) flush(buf);
+            }
+            if (!buf.empty()) flush(buf);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    if (std::fclose(f) != 0) write_error = true;
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    if (write_error) throw std::runtime_error("Error al escribir el fichero de salida: " + path);
+}
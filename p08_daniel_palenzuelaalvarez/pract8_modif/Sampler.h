@@ -0,0 +1,84 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Sampler.h: Generación aleatoria uniforme de cadenas de una longitud dada.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Sampler.h
+ * @brief Muestreo uniforme de derivaciones de longitud n en una gramática en FNC.
+ *
+ * Se apoya en las cuentas N(A, l) de DerivationCounter: para expandir A con
+ * longitud l se elige la regla A -> BC y el corte k con probabilidad
+ * N(B, k) * N(C, l - k) / N(A, l). Los cortes se prueban en orden
+ * alternado (1, l-1, 2, l-2, ...) y, dentro de cada corte, las reglas de A,
+ * con lo que el coste esperado por cadena es O(n log n) operaciones
+ * aritméticas para una gramática fija. Cada derivación tiene la misma
+ * probabilidad; si la gramática no es ambigua, también cada cadena.
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CYK.h"
+#include "DerivationCounter.h"
+
+/**
+ * @class UniformSampler
+ * @brief Generador de cadenas uniformes para longitudes hasta max_len.
+ */
+class UniformSampler {
+public:
+    /**
+     * @brief Precalcula las cuentas por no terminal y longitud.
+     * @param index Índice de la gramática en FNC.
+     * @param max_len Longitud máxima de las cadenas a generar.
+     * @param threads Hilos para el cálculo de las cuentas.
+     */
+    UniformSampler(const CNFIndex& index, size_t max_len, unsigned threads);
+
+    /**
+     * @brief Genera una cadena de longitud len desde el símbolo de arranque.
+     * @param len Longitud deseada.
+     * @param rng Generador pseudoaleatorio.
+     * @throws std::runtime_error Si no existe ninguna cadena de esa longitud.
+     */
+    std::string Sample(size_t len, std::mt19937_64& rng) const;
+
+    /**
+     * @brief Escribe count cadenas de longitud len en path, una por línea.
+     *
+     * Cada hilo usa su propio generador, sembrado con (seed, número de hilo),
+     * y vuelca bloques completos de líneas al fichero de salida. El conjunto
+     * de cadenas es reproducible para la misma semilla y número de hilos,
+     * aunque el orden de los bloques en el fichero puede variar.
+     *
+     * @throws std::runtime_error Si no se puede escribir el fichero o no hay cadenas de esa longitud.
+     */
+    void WriteSamples(const std::string& path, size_t count, size_t len, unsigned threads,
+                      uint64_t seed) const;
+
+private:
+    CNFIndex index_;
+    DerivationCounter counter_;
+    std::vector<std::vector<BinaryRule>> binary_by_lhs_; // A -> {A -> BC}
+    std::vector<std::vector<char>> unary_by_lhs_;        // A -> {a | A -> a}
+};
+
+#endif
@@ -0,0 +1,575 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Server.cc: Implementación del servidor de consultas.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Server.cc
+ * @brief Implementación de GrammarRegistry, ServeUnixSocket y QueryUnixSocket.
+ */
+
+#include "Server.h"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+void PutU32(std::string& out, uint32_t v) {
+    for (int s = 0; s < 32; s += 8) out += static_cast<char>((v >> s) & 0xFF);
+}
+
+uint32_t GetU32(const char* p) {
+    uint32_t v = 0;
+    for (int s = 0, i = 0; s < 32; s += 8, ++i) v |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << s;
+    return v;
+}
+
+/**
+ * @brief Lectura secuencial de los campos de una petición.
+ */
+class FieldReader {
+public:
+    FieldReader(const std::string& data, size_t pos) : data_(data), pos_(pos) {}
+
+    bool AtEnd() const { return pos_ == data_.size(); }
+
+    std::string Next() {
+        if (data_.size() - pos_ < 4) throw std::runtime_error("Petición mal formada.");
+        const uint32_t len = GetU32(data_.data() + pos_);
+        pos_ += 4;
+        if (data_.size() - pos_ < len) throw std::runtime_error("Petición mal formada.");
+        std::string field = data_.substr(pos_, len);
+        pos_ += len;
+        return field;
+    }
+
+private:
+    const std::string& data_;
+    size_t pos_;
+};
+
+std::string Reply(ServerStatus status, const std::string& body) {
+    std::string out(1, static_cast<char>(status));
+    return out + body;
+}
+
+std::runtime_error SystemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno) + ".");
+}
+
+/**
+ * @brief Dirección de un socket Unix con la ruta dada.
+ */
+sockaddr_un UnixAddress(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("Ruta de socket demasiado larga: " + path);
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+} // namespace
+
+std::string EncodeRequest(ServerOp op, const std::vector<std::string>& fields) {
+    std::string out(1, static_cast<char>(op));
+    for (const auto& f : fields) {
+        PutU32(out, static_cast<uint32_t>(f.size()));
+        out += f;
+    }
+    return out;
+}
+
+GrammarRegistry::GrammarRegistry(std::string output_dir) : output_dir_(std::move(output_dir)) {}
+
+std::string GrammarRegistry::Handle(const std::string& request) {
+    try {
+        if (request.empty()) throw std::runtime_error("Petición vacía.");
+        FieldReader fields(request, 1);
+        const std::string name = fields.Next();
+        switch (static_cast<ServerOp>(request[0])) {
+        case ServerOp::kLoad:
+            Load(name, fields.Next());
+            return Reply(ServerStatus::kOk, "");
+        case ServerOp::kConvert: {
+            std::string output = fields.AtEnd() ? "" : fields.Next();
+            std::string body;
+            PutU32(body, static_cast<uint32_t>(Convert(name, output)->compiled->Snapshot()->NumProductions()));
+            return Reply(ServerStatus::kOk, body);
+        }
+        case ServerOp::kMember: {
+            const std::string word = fields.Next();
+            std::shared_ptr<const Entry> entry = Find(name);
+            if (!entry->compiled) entry = Convert(name, "");
+            bool accepted = entry->compiled->Snapshot()->Accepts(word);
+            return Reply(ServerStatus::kOk, std::string(1, accepted ? 1 : 0));
+        }
+        case ServerOp::kReplace: {
+            const std::string lhs = fields.Next();
+            std::vector<Production> rules;
+            while (!fields.AtEnd()) {
+                Production p;
+                p.lhs = lhs;
+                std::istringstream rhs(fields.Next());
+                for (std::string tok; rhs >> tok;) p.rhs.push_back(tok);
+                rules.push_back(std::move(p));
+            }
+            std::shared_ptr<const Entry> entry = Find(name);
+            if (!entry->compiled) entry = Convert(name, "");
+            std::string body;
+            PutU32(body, static_cast<uint32_t>(entry->compiled->ReplaceRules(lhs, std::move(rules))->NumProductions()));
+            return Reply(ServerStatus::kOk, body);
+        }
+        case ServerOp::kReachable:
+            return Reply(ServerStatus::kOk, Find(name)->reachable);
+        }
+        throw std::runtime_error("Operación desconocida.");
+    } catch (const std::exception& e) {
+        return Reply(ServerStatus::kError, e.what());
+    }
+}
+
+std::shared_ptr<const GrammarRegistry::Entry> GrammarRegistry::Find(const std::string& name) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(name);
+    if (it == entries_.end()) throw std::runtime_error("No hay ninguna gramática cargada con el nombre '" + name + "'.");
+    return it->second;
+}
+
+/**
+ * @brief Lee y valida la gramática fuera del cerrojo y después la publica
+ *        (sustituyendo la anterior con el mismo nombre, si la hay).
+ */
+void GrammarRegistry::Load(const std::string& name, const std::string& path) {
+    auto entry = std::make_shared<Entry>();
+    entry->source.ReadFromFile(path);
+    entry->source.ValidateFormat();
+    for (int id : entry->source.ReachableNonTerminals()) {
+        if (!entry->reachable.empty()) entry->reachable += ' ';
+        entry->reachable += entry->source.SymbolName(id);
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    entries_[name] = std::move(entry);
+}
+
+/**
+ * @brief Ruta de un fichero de salida dentro del directorio configurado.
+ * @throws std::runtime_error Si no hay directorio o file no es un nombre simple.
+ */
+std::string GrammarRegistry::OutputPath(const std::string& file) const {
+    if (output_dir_.empty()) throw std::runtime_error("El servidor no tiene directorio de salida.");
+    if (file.find('/') != std::string::npos || file == "." || file == "..")
+        throw std::runtime_error("Nombre de fichero de salida no válido: '" + file + "'.");
+    return output_dir_ + "/" + file;
+}
+
+/**
+ * @brief Convierte una copia de la gramática a FNC y publica una entrada
+ *        nueva con su instantánea compilada. Si mientras tanto se ha cargado otra
+ *        gramática con el mismo nombre, se conserva la nueva.
+ */
+std::shared_ptr<const GrammarRegistry::Entry> GrammarRegistry::Convert(const std::string& name,
+                                                                       const std::string& output) {
+    const std::string path = output.empty() ? "" : OutputPath(output);
+    std::shared_ptr<const Entry> old = Find(name);
+    auto entry = std::make_shared<Entry>(*old);
+    Grammar cnf = old->source;
+    cnf.CheckPreconditions();
+    cnf.TransformToCNF();
+    if (!path.empty()) cnf.WriteToFile(path);
+    entry->compiled = std::make_shared<GrammarPublisher>(CompiledGrammar::FromGrammar(cnf));
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(name);
+    if (it != entries_.end() && it->second == old) it->second = entry;
+    return entry;
+}
+
+namespace {
+
+/**
+ * @brief Estado de una conexión en el hilo de E/S.
+ *
+ * Mientras una petición de la conexión está en un trabajador (busy) no se
+ * lee del socket: las siguientes esperan en el búfer de entrada o en el
+ * propio socket, así que las respuestas salen en orden y el búfer no crece
+ * más de una trama máxima.
+ */
+struct Connection {
+    uint64_t id = 0;
+    int fd = -1;
+    std::string in;    // bytes recibidos
+    size_t in_pos = 0; // inicio de la primera trama sin atender
+    std::string out;   // bytes por enviar
+    size_t out_pos = 0;
+    bool busy = false;
+    bool eof = false;        // el cliente ya no va a enviar más
+    bool want_write = false; // hay bytes por enviar
+    uint32_t watched = EPOLLIN; // eventos registrados en epoll
+};
+
+struct Job {
+    uint64_t conn; // id de la conexión
+    std::string payload;
+};
+
+/**
+ * @brief Bucle de E/S y reparto de peticiones entre los trabajadores.
+ *
+ * Las conexiones se identifican en epoll por un id creciente en lugar de por
+ * su descriptor, para que la respuesta de una conexión ya cerrada no llegue
+ * a otra que haya reutilizado el descriptor.
+ */
+class EventLoop {
+public:
+    EventLoop(int listen_fd, int signal_fd, GrammarRegistry& registry, unsigned workers)
+        : listen_fd_(listen_fd), signal_fd_(signal_fd), registry_(registry) {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epoll_fd_ < 0 || event_fd_ < 0) throw SystemError("No se puede crear epoll");
+        Watch(listen_fd_, kListenId, EPOLLIN);
+        Watch(signal_fd_, kSignalId, EPOLLIN);
+        Watch(event_fd_, kDoneId, EPOLLIN);
+        for (unsigned t = 0; t < (workers == 0 ? 1 : workers); ++t) pool_.emplace_back([this] { Work(); });
+    }
+
+    ~EventLoop() {
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            stop_ = true;
+        }
+        jobs_cv_.notify_all();
+        for (auto& th : pool_) th.join();
+        for (auto& c : conns_) close(c.second.fd);
+        close(event_fd_);
+        close(epoll_fd_);
+    }
+
+    void Run() {
+        epoll_event events[64];
+        for (;;) {
+            int n = epoll_wait(epoll_fd_, events, 64, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw SystemError("epoll_wait");
+            }
+            for (int e = 0; e < n; ++e) {
+                const uint64_t id = events[e].data.u64;
+                if (id == kSignalId) return;
+                if (id == kListenId) {
+                    Accept();
+                } else if (id == kDoneId) {
+                    Deliver();
+                } else {
+                    auto it = conns_.find(id);
+                    if (it == conns_.end()) continue;
+                    if (events[e].events & (EPOLLERR | EPOLLHUP)) {
+                        Close(it);
+                        continue;
+                    }
+                    if ((events[e].events & EPOLLOUT) && !Flush(it->second)) {
+                        Close(it);
+                        continue;
+                    }
+                    if ((events[e].events & EPOLLIN) && !Receive(it)) {
+                        Close(it);
+                        continue;
+                    }
+                    if (Finished(it->second)) Close(it);
+                }
+            }
+        }
+    }
+
+private:
+    static const uint64_t kListenId = 0, kSignalId = 1, kDoneId = 2;
+    static const uint32_t kIn = EPOLLIN, kOut = EPOLLOUT;
+
+    int listen_fd_, signal_fd_, epoll_fd_ = -1, event_fd_ = -1;
+    GrammarRegistry& registry_;
+    std::unordered_map<uint64_t, Connection> conns_;
+    uint64_t next_id_ = 3;
+
+    std::vector<std::thread> pool_;
+    std::mutex jobs_mutex_;
+    std::condition_variable jobs_cv_;
+    std::deque<Job> jobs_;
+    bool stop_ = false;
+    std::mutex done_mutex_;
+    std::deque<Job> done_; // respuestas pendientes de entregar
+
+    void Watch(int fd, uint64_t id, uint32_t events, int op = EPOLL_CTL_ADD) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.u64 = id;
+        if (epoll_ctl(epoll_fd_, op, fd, &ev) < 0) throw SystemError("epoll_ctl");
+    }
+
+    void Accept() {
+        for (;;) {
+            int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return; // EAGAIN o error transitorio del cliente
+            const uint64_t id = next_id_++;
+            Connection c;
+            c.id = id;
+            c.fd = fd;
+            conns_.emplace(id, std::move(c));
+            Watch(fd, id, EPOLLIN);
+        }
+    }
+
+    void Close(std::unordered_map<uint64_t, Connection>::iterator it) {
+        close(it->second.fd); // también lo quita de epoll
+        conns_.erase(it);
+    }
+
+    /**
+     * @brief Lee todo lo disponible y despacha la siguiente trama.
+     * @return false si hay que cerrar la conexión.
+     */
+    bool Receive(std::unordered_map<uint64_t, Connection>::iterator it) {
+        Connection& c = it->second;
+        char buf[1 << 16];
+        for (;;) {
+            ssize_t r = read(c.fd, buf, sizeof(buf));
+            if (r > 0) {
+                c.in.append(buf, static_cast<size_t>(r));
+                // Con más de una trama máxima pendiente ya hay una completa (o
+                // una demasiado larga); el resto se queda en el socket
+                if (c.in.size() - c.in_pos > kMaxFrameSize + 4) break;
+                continue;
+            }
+            if (r == 0) {
+                // Fin de la escritura del cliente: se atiende lo recibido y se cierra
+                c.eof = true;
+                Rearm(c);
+                break;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        return Dispatch(c);
+    }
+
+    /**
+     * @brief Indica si la conexión ya ha recibido fin de fichero y no le
+     *        queda nada por atender ni por enviar.
+     */
+    static bool Finished(const Connection& c) {
+        return c.eof && !c.busy && c.out.empty() && (c.in.size() - c.in_pos < 4 || !Complete(c));
+    }
+
+    static bool Complete(const Connection& c) {
+        return c.in.size() - c.in_pos - 4 >= GetU32(c.in.data() + c.in_pos);
+    }
+
+    /**
+     * @brief Entrega a los trabajadores la primera trama completa, si la
+     *        conexión no tiene ya una petición en curso.
+     */
+    bool Dispatch(Connection& c) {
+        if (c.busy || c.in.size() - c.in_pos < 4) return true;
+        const uint32_t len = GetU32(c.in.data() + c.in_pos);
+        if (len > kMaxFrameSize) return false;
+        if (!Complete(c)) return true;
+        Job job{c.id, c.in.substr(c.in_pos + 4, len)};
+        c.in_pos += 4 + len;
+        if (c.in_pos == c.in.size() || c.in_pos > (1u << 16)) {
+            c.in.erase(0, c.in_pos);
+            c.in_pos = 0;
+        }
+        c.busy = true;
+        Rearm(c);
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        jobs_cv_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Envía lo que admita el socket y activa o desactiva EPOLLOUT.
+     * @return false si hay que cerrar la conexión.
+     */
+    bool Flush(Connection& c) {
+        while (c.out_pos < c.out.size()) {
+            ssize_t w = send(c.fd, c.out.data() + c.out_pos, c.out.size() - c.out_pos, MSG_NOSIGNAL);
+            if (w > 0) {
+                c.out_pos += static_cast<size_t>(w);
+            } else if (w < 0 && errno == EINTR) {
+                continue;
+            } else if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                return false;
+            }
+        }
+        if (c.out_pos == c.out.size()) {
+            c.out.clear();
+            c.out_pos = 0;
+        }
+        c.want_write = !c.out.empty();
+        Rearm(c);
+        return true;
+    }
+
+    /**
+     * @brief Ajusta los eventos de epoll de la conexión: lectura si no ha
+     *        llegado el fin de fichero ni hay una petición en curso, y
+     *        escritura si queda algo por enviar.
+     */
+    void Rearm(Connection& c) {
+        const uint32_t events = (c.eof || c.busy ? 0u : kIn) | (c.want_write ? kOut : 0u);
+        if (events == c.watched) return;
+        c.watched = events;
+        Watch(c.fd, c.id, events, EPOLL_CTL_MOD);
+    }
+
+    /**
+     * @brief Pasa las respuestas de los trabajadores a los búferes de salida.
+     */
+    void Deliver() {
+        uint64_t count;
+        while (read(event_fd_, &count, sizeof(count)) < 0 && errno == EINTR) {}
+        std::deque<Job> done;
+        {
+            std::lock_guard<std::mutex> lock(done_mutex_);
+            done.swap(done_);
+        }
+        for (auto& d : done) {
+            auto it = conns_.find(d.conn);
+            if (it == conns_.end()) continue; // el cliente ya se ha ido
+            Connection& c = it->second;
+            PutU32(c.out, static_cast<uint32_t>(d.payload.size()));
+            c.out += d.payload;
+            c.busy = false;
+            if (!Flush(c) || !Dispatch(c) || Finished(c)) Close(it);
+        }
+    }
+
+    void Work() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(jobs_mutex_);
+                jobs_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+                if (stop_) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job.payload = registry_.Handle(job.payload);
+            bool wake;
+            {
+                std::lock_guard<std::mutex> lock(done_mutex_);
+                wake = done_.empty(); // si no, el hilo de E/S ya tiene un aviso pendiente
+                done_.push_back(std::move(job));
+            }
+            if (wake) {
+                const uint64_t one = 1;
+                while (write(event_fd_, &one, sizeof(one)) < 0 && errno == EINTR) {}
+            }
+        }
+    }
+};
+
+} // namespace
+
+void ServeUnixSocket(const std::string& path, GrammarRegistry& registry, unsigned workers) {
+    // SIGINT y SIGTERM se reciben por un descriptor en lugar de interrumpir
+    // hilos; se bloquean antes de crear los trabajadores para que lo hereden
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    int signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd < 0) throw SystemError("signalfd");
+
+    sockaddr_un addr = UnixAddress(path);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        close(signal_fd);
+        throw SystemError("No se puede crear el socket");
+    }
+    unlink(path.c_str());
+    // Permisos antes de listen(): hasta entonces nadie se puede conectar
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || chmod(path.c_str(), 0600) < 0 ||
+        listen(listen_fd, SOMAXCONN) < 0) {
+        std::runtime_error error = SystemError("No se puede escuchar en " + path);
+        close(listen_fd);
+        close(signal_fd);
+        throw error;
+    }
+
+    try {
+        EventLoop(listen_fd, signal_fd, registry, workers).Run();
+    } catch (...) {
+        close(listen_fd);
+        close(signal_fd);
+        unlink(path.c_str());
+        throw;
+    }
+    close(listen_fd);
+    close(signal_fd);
+    unlink(path.c_str());
+}
+
+std::string QueryUnixSocket(const std::string& path, const std::string& request) {
+    sockaddr_un addr = UnixAddress(path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw SystemError("No se puede crear el socket");
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::runtime_error error = SystemError("No se puede conectar con " + path);
+        close(fd);
+        throw error;
+    }
+    std::string frame;
+    PutU32(frame, static_cast<uint32_t>(request.size()));
+    frame += request;
+    std::string reply;
+    bool ok = true;
+    for (size_t sent = 0; ok && sent < frame.size();) {
+        ssize_t w = send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+        if (w > 0) sent += static_cast<size_t>(w);
+        else ok = w < 0 && errno == EINTR;
+    }
+    char buf[1 << 16];
+    while (ok && (reply.size() < 4 || reply.size() - 4 < GetU32(reply.data()))) {
+        ssize_t r = read(fd, buf, sizeof(buf));
+        if (r > 0) reply.append(buf, static_cast<size_t>(r));
+        else ok = r < 0 && errno == EINTR;
+    }
+    close(fd);
+    if (!ok) throw std::runtime_error("El servidor ha cerrado la conexión.");
+    return reply.substr(4, GetU32(reply.data()));
+}
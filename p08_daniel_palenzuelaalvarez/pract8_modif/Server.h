@@ -0,0 +1,146 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Server.h: Servidor de consultas sobre gramáticas residentes en memoria.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Server.h
+ * @brief Servidor por socket Unix que mantiene gramáticas cargadas y
+ *        convertidas entre consultas.
+ *
+ * Protocolo (todos los enteros son de 32 bits sin signo, little-endian):
+ *   trama     = longitud del contenido, contenido
+ *   petición  = operación (1 byte), campos
+ *   campo     = longitud, bytes
+ *   respuesta = estado (1 byte: 0 correcto, 1 error), cuerpo
+ *
+ * Operaciones y cuerpo de la respuesta correcta:
+ *   1 cargar     (nombre, ruta)          -> vacío
+ *   2 convertir  (nombre[, fichero])     -> número de producciones en FNC
+ *   3 pertenecer (nombre, cadena)        -> 1 byte: 1 aceptada, 0 rechazada
+ *   4 alcanzables (nombre)               -> nombres separados por espacios
+ *   5 reemplazar (nombre, A, reglas...)  -> número de producciones en FNC
+ * En caso de error el cuerpo es el mensaje. Las respuestas de una conexión
+ * llegan en el orden de sus peticiones.
+ *
+ * Convertir con fichero escribe la FNC en el directorio de salida del
+ * servidor; el fichero es un nombre sin '/', y sin directorio configurado se
+ * rechaza. El socket se crea con permisos 0600 (solo el usuario del servidor).
+ *
+ * Reemplazar sustituye todas las reglas de A en la gramática convertida (se
+ * convierte antes si hace falta); cada regla es su RHS en FNC con los símbolos
+ * separados por espacios ("a" o "B C"). Las pertenencias en curso terminan
+ * con la versión anterior. Convertir de nuevo descarta estas ediciones.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "CompiledGrammar.h"
+
+/**
+ * @brief Operaciones del protocolo.
+ */
+enum class ServerOp : uint8_t { kLoad = 1, kConvert = 2, kMember = 3, kReachable = 4, kReplace = 5 };
+
+/**
+ * @brief Primer byte de cada respuesta.
+ */
+enum class ServerStatus : uint8_t { kOk = 0, kError = 1 };
+
+/**
+ * @brief Tamaño máximo del contenido de una trama (16 MB).
+ */
+const uint32_t kMaxFrameSize = 16u << 20;
+
+/**
+ * @brief Codifica una petición (sin la longitud de la trama).
+ */
+std::string EncodeRequest(ServerOp op, const std::vector<std::string>& fields);
+
+/**
+ * @class GrammarRegistry
+ * @brief Gramáticas cargadas por nombre, compartidas entre los hilos del servidor.
+ *
+ * Cada gramática se guarda en una entrada inmutable; convertir crea una
+ * entrada nueva y la sustituye, de modo que las consultas en curso siguen
+ * usando la anterior sin cerrojos mientras se hace la conversión. La
+ * gramática convertida se publica en un GrammarPublisher: las pertenencias
+ * toman su instantánea vigente y las ediciones publican otra.
+ */
+class GrammarRegistry {
+public:
+    /**
+     * @param output_dir Directorio donde convertir puede escribir la FNC
+     *        (vacío: convertir no escribe ficheros).
+     */
+    explicit GrammarRegistry(std::string output_dir = "");
+
+    /**
+     * @brief Atiende una petición y devuelve la respuesta codificada.
+     *
+     * Se puede llamar desde varios hilos a la vez. Los errores (petición mal
+     * formada, gramática inexistente o no válida...) se devuelven como
+     * respuesta con estado de error.
+     */
+    std::string Handle(const std::string& request);
+
+private:
+    struct Entry {
+        Grammar source;                           // gramática de entrada validada
+        std::string reachable;                    // alcanzables desde el símbolo de arranque
+        std::shared_ptr<GrammarPublisher> compiled; // nulo hasta convertir
+    };
+
+    const std::string output_dir_;
+    std::map<std::string, std::shared_ptr<const Entry>> entries_;
+    std::shared_mutex mutex_; // protege entries_ (no el contenido de las entradas)
+
+    std::shared_ptr<const Entry> Find(const std::string& name);
+    void Load(const std::string& name, const std::string& path);
+    std::shared_ptr<const Entry> Convert(const std::string& name, const std::string& output);
+    std::string OutputPath(const std::string& file) const;
+};
+
+/**
+ * @brief Atiende peticiones en el socket Unix dado hasta recibir SIGINT o SIGTERM.
+ *
+ * Un hilo hace toda la E/S con epoll sobre sockets no bloqueantes y reparte
+ * las peticiones completas entre un número fijo de hilos trabajadores. El
+ * socket solo admite conexiones del usuario del servidor (permisos 0600). Al
+ * terminar se borra el socket.
+ *
+ * @param path Ruta del socket (si ya existe, se reemplaza).
+ * @param registry Gramáticas disponibles.
+ * @param workers Número de hilos trabajadores.
+ * @throws std::runtime_error Si no se puede crear el socket.
+ */
+void ServeUnixSocket(const std::string& path, GrammarRegistry& registry, unsigned workers);
+
+/**
+ * @brief Envía una petición al servidor y devuelve su respuesta (sin la longitud).
+ * @throws std::runtime_error Si falla la conexión.
+ */
+std::string QueryUnixSocket(const std::string& path, const std::string& request);
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: SpscQueue.h: Cola acotada sin cerrojos de un productor y un consumidor.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file SpscQueue.h
+ * @brief Cola circular acotada para comunicar dos hilos (un productor y un consumidor).
+ *
+ * El productor solo escribe tail_ y el consumidor solo escribe head_; cada uno
+ * publica su avance con memory_order_release y lee el del otro con
+ * memory_order_acquire, así que no hacen falta cerrojos. Ambos índices están
+ * en líneas de caché distintas para que no se invaliden mutuamente.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SpscQueue
+ * @brief Cola acotada sin cerrojos de un solo productor y un solo consumidor.
+ *
+ * Push() y Pop() esperan (cediendo el procesador) mientras la cola está llena
+ * o vacía, y devuelven false si se activa la señal de parada, de modo que un
+ * error en una etapa no deja bloqueadas a las demás.
+ */
+template <class T>
+class SpscQueue {
+public:
+    /**
+     * @brief Crea una cola con capacidad para capacity elementos.
+     */
+    explicit SpscQueue(size_t capacity) : slots_(capacity + 1) {}
+
+    /**
+     * @brief Añade un elemento (solo el hilo productor).
+     * @param value Elemento a añadir (se mueve).
+     * @param stop Señal de parada.
+     * @return false si se ha parado antes de poder añadirlo.
+     */
+    bool Push(T&& value, const std::atomic<bool>& stop) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = tail + 1 == slots_.size() ? 0 : tail + 1;
+        while (next == head_.load(std::memory_order_acquire)) {
+            if (stop.load(std::memory_order_relaxed)) return false;
+            std::this_thread::yield();
+        }
+        slots_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Extrae el elemento más antiguo (solo el hilo consumidor).
+     * @param value Elemento extraído (salida).
+     * @param stop Señal de parada.
+     * @return false si se ha parado antes de poder extraerlo.
+     */
+    bool Pop(T& value, const std::atomic<bool>& stop) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        while (head == tail_.load(std::memory_order_acquire)) {
+            if (stop.load(std::memory_order_relaxed)) return false;
+            std::this_thread::yield();
+        }
+        value = std::move(slots_[head]);
+        head_.store(head + 1 == slots_.size() ? 0 : head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> slots_;                // una posición libre distingue llena de vacía
+    alignas(64) std::atomic<size_t> head_{0}; // siguiente posición a leer (consumidor)
+    alignas(64) std::atomic<size_t> tail_{0}; // siguiente posición a escribir (productor)
+};
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Valiant.cc: Implementación del reconocedor por producto de matrices.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+*/
+
+/**
+ * @file Valiant.cc
+ * @brief Implementación de ValiantRecognizer.
+ */
+
+#include "Valiant.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief Lado máximo de los bloques que se rellenan directamente. Todos los
+ *        límites de bloque son múltiplos de kLeaf, así que los productos
+ *        trabajan siempre con palabras de 64 bits completas.
+ */
+const size_t kLeaf = 64;
+
+/**
+ * @brief Columnas (en palabras) de cada franja en los productos con Cuatro
+ *        Rusos: la tabla de 256 combinaciones ocupa 16 KB.
+ */
+const size_t kStripWords = 8;
+
+/**
+ * @brief Indica si a y b tienen algún bit común en las posiciones [from, to).
+ */
+bool Meets(const uint64_t* a, const uint64_t* b, size_t from, size_t to) {
+    if (from >= to) return false;
+    const size_t w0 = from / 64, w1 = (to - 1) / 64;
+    for (size_t w = w0; w <= w1; ++w) {
+        uint64_t x = a[w] & b[w];
+        if (w == w0) x &= ~uint64_t(0) << (from % 64);
+        if (w == w1 && to % 64 != 0) x &= ~uint64_t(0) >> (64 - to % 64);
+        if (x) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Matrices de un análisis: T_A por filas, T_A traspuesta (para
+ *        recorrer una columna como palabras) y P_A, que acumula los A
+ *        obtenidos por productos antes de completar cada celda.
+ */
+class ValiantRun {
+public:
+    ValiantRun(const CNFIndex& index, size_t n, bool four_russians)
+        : rules_(index.BinaryRules()),
+          size_((n + 1 + kLeaf - 1) / kLeaf * kLeaf),
+          words_(size_ / 64),
+          four_russians_(four_russians) {
+        const size_t cells = static_cast<size_t>(index.NumNonTerminals()) * size_ * words_;
+        t_.assign(cells, 0);
+        tt_.assign(cells, 0);
+        p_.assign(cells, 0);
+    }
+
+    size_t Size() const { return size_; }
+
+    void Set(int a, size_t i, size_t j) {
+        T(a, i)[j / 64] |= uint64_t(1) << (j % 64);
+        TT(a, j)[i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    bool Has(int a, size_t i, size_t j) const { return (T(a, i)[j / 64] >> (j % 64)) & 1; }
+
+    /**
+     * @brief Rellena las celdas (i, j) con l <= i < j < m.
+     */
+    void Compute(size_t l, size_t m) {
+        if (m - l <= kLeaf) {
+            LeafCompute(l, m);
+            return;
+        }
+        const size_t mid = Mid(l, m);
+        Compute(l, mid);
+        Compute(mid, m);
+        Complete(l, mid, mid, m);
+    }
+
+private:
+    const std::vector<BinaryRule>& rules_;
+    size_t size_;  // lado de las matrices (n + 1 redondeado a múltiplo de kLeaf)
+    size_t words_; // palabras por fila
+    bool four_russians_;
+    std::vector<uint64_t> t_, tt_, p_; // [no terminal][fila][palabra]
+    std::vector<uint64_t> table_;     // tabla de Cuatro Rusos
+
+    uint64_t* T(int a, size_t i) { return &t_[(a * size_ + i) * words_]; }
+    const uint64_t* T(int a, size_t i) const { return &t_[(a * size_ + i) * words_]; }
+    uint64_t* TT(int a, size_t j) { return &tt_[(a * size_ + j) * words_]; }
+    uint64_t* P(int a, size_t i) { return &p_[(a * size_ + i) * words_]; }
+
+    static size_t Mid(size_t l, size_t m) { return l + (m - l) / kLeaf / 2 * kLeaf; }
+
+    /**
+     * @brief Relleno directo de un bloque diagonal pequeño, por longitudes.
+     */
+    void LeafCompute(size_t l, size_t m) {
+        for (size_t len = 2; l + len < m; ++len) {
+            for (size_t i = l; i + len < m; ++i) {
+                const size_t j = i + len;
+                for (const auto& r : rules_) {
+                    if (!Has(r.lhs, i, j) && Meets(T(r.left, i), TT(r.right, j), i + 1, j)) Set(r.lhs, i, j);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Completa las celdas i en [b0, b1), j en [c0, c1).
+     *
+     * Precondición (Okhotin): T ya está calculada dentro de [b0, b1)^2 y de
+     * [c0, c1)^2, y P contiene los productos con corte k en [b1, c0).
+     */
+    void Complete(size_t b0, size_t b1, size_t c0, size_t c1) {
+        const bool split_b = b1 - b0 > kLeaf, split_c = c1 - c0 > kLeaf;
+        if (!split_b && !split_c) {
+            LeafComplete(b0, b1, c0, c1);
+        } else if (split_b && split_c) {
+            const size_t bm = Mid(b0, b1), cm = Mid(c0, c1);
+            Complete(bm, b1, c0, cm);
+            Multiply(b0, bm, bm, b1, c0, cm);
+            Complete(b0, bm, c0, cm);
+            Multiply(bm, b1, c0, cm, cm, c1);
+            Complete(bm, b1, cm, c1);
+            Multiply(b0, bm, bm, b1, cm, c1);
+            Multiply(b0, bm, c0, cm, cm, c1);
+            Complete(b0, bm, cm, c1);
+        } else if (split_b) {
+            const size_t bm = Mid(b0, b1);
+            Complete(bm, b1, c0, c1);
+            Multiply(b0, bm, bm, b1, c0, c1);
+            Complete(b0, bm, c0, c1);
+        } else {
+            const size_t cm = Mid(c0, c1);
+            Complete(b0, b1, c0, cm);
+            Multiply(b0, b1, c0, cm, cm, c1);
+            Complete(b0, b1, cm, c1);
+        }
+    }
+
+    /**
+     * @brief Relleno directo de un bloque pequeño fuera de la diagonal: filas
+     *        de abajo arriba y columnas de izquierda a derecha, de modo que los
+     *        cortes dentro del propio bloque ya están calculados.
+     */
+    void LeafComplete(size_t b0, size_t b1, size_t c0, size_t c1) {
+        for (size_t i = b1; i-- > b0;) {
+            for (size_t j = c0; j < c1; ++j) {
+                if (j == i + 1) continue; // celda de longitud 1 (reglas unarias)
+                for (const auto& r : rules_) {
+                    if (Has(r.lhs, i, j)) continue;
+                    const uint64_t* row = T(r.left, i);
+                    const uint64_t* col = TT(r.right, j);
+                    if (((P(r.lhs, i)[j / 64] >> (j % 64)) & 1) || Meets(row, col, i + 1, b1) || Meets(row, col, c0, j))
+                        Set(r.lhs, i, j);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief P_A[X, Z] |= T_B[X, Y] x T_C[Y, Z] para cada regla A -> BC, con
+     *        X = [x0, x1), Y = [y0, y1) y Z = [z0, z1).
+     *
+     * Por bloques de 64 cortes k: las 64 filas de T_C que se combinan caben en
+     * caché mientras se recorren todas las filas i de X.
+     */
+    void Multiply(size_t x0, size_t x1, size_t y0, size_t y1, size_t z0, size_t z1) {
+        const size_t zw0 = z0 / 64, zw1 = z1 / 64;
+        for (const auto& r : rules_) {
+            if (four_russians_) {
+                MultiplyFourRussians(r, x0, x1, y0, y1, zw0, zw1);
+                continue;
+            }
+            for (size_t yw = y0 / 64; yw < y1 / 64; ++yw) {
+                for (size_t i = x0; i < x1; ++i) {
+                    uint64_t bits = T(r.left, i)[yw];
+                    if (bits == 0) continue;
+                    uint64_t* out = P(r.lhs, i);
+                    while (bits) {
+                        const size_t k = yw * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                        bits &= bits - 1;
+                        const uint64_t* src = T(r.right, k);
+                        for (size_t w = zw0; w < zw1; ++w) out[w] |= src[w];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Producto con Cuatro Rusos: para cada grupo de 8 cortes y franja
+     *        de columnas se precalcula la unión de cada subconjunto de esas 8
+     *        filas de T_C, y cada fila i hace una sola unión por grupo.
+     */
+    void MultiplyFourRussians(const BinaryRule& r, size_t x0, size_t x1, size_t y0, size_t y1,
+                              size_t zw0, size_t zw1) {
+        table_.resize(256 * kStripWords);
+        for (size_t s0 = zw0; s0 < zw1; s0 += kStripWords) {
+            const size_t sw = std::min(kStripWords, zw1 - s0);
+            for (size_t k0 = y0; k0 < y1; k0 += 8) {
+                for (size_t w = 0; w < sw; ++w) table_[w] = 0;
+                for (size_t mask = 1; mask < 256; ++mask) {
+                    const size_t low = static_cast<size_t>(__builtin_ctzll(mask));
+                    const uint64_t* prev = &table_[(mask & (mask - 1)) * kStripWords];
+                    const uint64_t* src = T(r.right, k0 + low) + s0;
+                    uint64_t* dst = &table_[mask * kStripWords];
+                    for (size_t w = 0; w < sw; ++w) dst[w] = prev[w] | src[w];
+                }
+                for (size_t i = x0; i < x1; ++i) {
+                    const size_t byte = (T(r.left, i)[k0 / 64] >> (k0 % 64)) & 0xFF;
+                    if (byte == 0) continue;
+                    const uint64_t* src = &table_[byte * kStripWords];
+                    uint64_t* out = P(r.lhs, i) + s0;
+                    for (size_t w = 0; w < sw; ++w) out[w] |= src[w];
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+ValiantRecognizer::ValiantRecognizer(const CNFIndex& index, bool four_russians)
+    : index_(index), four_russians_(four_russians), unary_by_char_(256) {
+    for (const auto& r : index_.UnaryRules()) unary_by_char_[static_cast<unsigned char>(r.terminal)].push_back(r.lhs);
+}
+
+/**
+ * @brief Celdas de longitud 1 con las reglas unarias y después el
+ *        procedimiento compute de Okhotin sobre toda la matriz.
+ */
+bool ValiantRecognizer::Accepts(const std::string& word) const {
+    // Una gramática en FNC (sin producción vacía) no genera la cadena vacía
+    if (word.empty()) return false;
+    const size_t n = word.size();
+    ValiantRun run(index_, n, four_russians_);
+    for (size_t i = 0; i < n; ++i) {
+        for (int a : unary_by_char_[static_cast<unsigned char>(word[i])]) run.Set(a, i, i + 1);
+    }
+    run.Compute(0, run.Size());
+    return run.Has(index_.Start(), 0, n);
+}
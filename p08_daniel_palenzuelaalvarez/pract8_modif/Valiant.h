@@ -0,0 +1,68 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingeniería Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 2º
+ * Práctica 8: Gramáticas en Forma Normal de Chomsky.
+ * Autor: Daniel Palenzuela Álvarez
+ * Correo: alu0101140469@ull.edu.es
+ * Fecha: 04/11/2025
+ * Archivo: Valiant.h: Reconocedor de gramáticas en FNC por producto de matrices booleanas.
+ * Referencias:
+ *    Transparencias del Tema 3 de la asignatura: Lenguajes y Gramáticas Independientes
+ *    del Contexto:
+ *    https://campusvirtual.ull.es/2526/ingenieriaytecnologia/mod/resource/view.php?id=11876
+ *    L. G. Valiant. General Context-Free Recognition in Less than Cubic Time.
+ *    JCSS 10(2), 1975.
+ *    A. Okhotin. Parsing by Matrix Multiplication Generalized to Boolean
+ *    Grammars. TCS 516, 2014.
+*/
+
+/**
+ * @file Valiant.h
+ * @brief Algoritmo de Valiant (en la formulación de Okhotin) sobre matrices
+ *        de bits.
+ *
+ * La tabla CYK se guarda como una matriz booleana (n+1) x (n+1) por no
+ * terminal: T_A[i][j] indica que A genera w[i..j). El relleno se organiza por
+ * bloques de modo que la mayor parte del trabajo son productos de submatrices
+ * T_B x T_C (uno por regla A -> BC), que se hacen por filas de 64 bits y,
+ * opcionalmente, con tablas de Cuatro Rusos sobre grupos de 8 filas.
+ *
+ * Memoria: tres matrices de (n+1)^2 bits por no terminal.
+ */
+
+#ifndef VALIANT_H
+#define VALIANT_H
+
+#include <string>
+#include <vector>
+
+#include "CYK.h"
+
+/**
+ * @class ValiantRecognizer
+ * @brief Reconocedor subcúbico para gramáticas en FNC.
+ */
+class ValiantRecognizer {
+public:
+    /**
+     * @brief Prepara el reconocedor para el índice dado.
+     * @param index Índice de la gramática en FNC (se copia).
+     * @param four_russians Usar tablas de Cuatro Rusos en los productos.
+     */
+    explicit ValiantRecognizer(const CNFIndex& index, bool four_russians = false);
+
+    /**
+     * @brief Decide si la cadena pertenece al lenguaje de la gramática.
+     */
+    bool Accepts(const std::string& word) const;
+
+private:
+    CNFIndex index_;
+    bool four_russians_;
+    std::vector<std::vector<int>> unary_by_char_; // byte -> {A | A -> byte}
+};
+
+#endif
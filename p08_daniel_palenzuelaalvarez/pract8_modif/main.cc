@@ -36,17 +36,927 @@
  * la gramática a Forma Normal de Chomsky y escribe el resultado.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 #include "Grammar2CNF.h"
+#include "CYK.h"
+#include "AllocCounter.h"
+#include "CodeGenerator.h"
+#include "CompactRules.h"
+#include "DerivationCounter.h"
+#include "GLR.h"
+#include "LALR.h"
+#include "Mixed.h"
+#include "OnlineCYK.h"
+#include "Parallel.h"
+#include "ParseForest.h"
+#include "Regular.h"
+#include "Sampler.h"
+#include "Server.h"
+#include "Valiant.h"
 
 // Mensaje de ayuda
 static const char* kUsage =
-    "Uso: Grammar2CNF input.gra output.gra\n"
+    "Uso: Grammar2CNF [--minimize] [--group-terminals] [--threads N] input.gra output.gra\n"
+    "     Grammar2CNF --emit-cpp input.gra reconocedor.cc\n"
+    "     Grammar2CNF --bench input.gra cadena [repeticiones]\n"
+    "     Grammar2CNF --count input.gra N [modulo]\n"
+    "     Grammar2CNF --sample input.gra cantidad longitud salida.txt [hilos] [semilla]\n"
+    "     Grammar2CNF --forest input.gra cadena\n"
+    "     Grammar2CNF --check input.gra\n"
+    "     Grammar2CNF --stream input.gra output.gra\n"
+    "     Grammar2CNF --pipeline input.gra output.gra\n"
+    "     Grammar2CNF --stats input.gra\n"
+    "     Grammar2CNF --alloc input.gra output.gra\n"
+    "     Grammar2CNF --alloc-growth pequeña.gra grande.gra limites.txt\n"
+    "     Grammar2CNF --analyze input.gra\n"
+    "     Grammar2CNF --lalr input.gra cadena\n"
+    "     Grammar2CNF --glr input.gra cadena [repeticiones]\n"
+    "     Grammar2CNF --valiant input.gra cadena [repeticiones] [--four-russians]\n"
+    "     Grammar2CNF --crossover input.gra [longitud_max]\n"
+    "     Grammar2CNF --online input.gra [cadena]\n"
+    "     Grammar2CNF --regular input.gra [cadena]\n"
+    "     Grammar2CNF --mixed input.gra cadena [repeticiones]\n"
+    "     Grammar2CNF --serve socket [hilos] [directorio_salida]\n"
+    "     Grammar2CNF --query socket load|convert|member|reachable nombre [argumento]\n"
+    "     Grammar2CNF --query socket replace nombre A [regla...]\n"
     "Opciones:\n"
-    "  --help    Muestra este texto de ayuda.\n";
+    "  --help      Muestra este texto de ayuda.\n"
+    "  --minimize  Tras la conversión, fusiona los no terminales con reglas idénticas.\n"
+    "  --group-terminals\n"
+    "              Crea un único Ca por clase de terminales equivalentes (los que\n"
+    "              aparecen en las mismas posiciones de las mismas reglas).\n"
+    "  --threads   Número de hilos para la conversión (por defecto, los núcleos disponibles).\n"
+    "  --emit-cpp  Genera un reconocedor CYK en C++ especializado para la gramática en FNC.\n"
+    "  --bench     Mide el reconocedor CYK genérico con la cadena dada (mismo formato\n"
+    "              de salida que el reconocedor generado con --emit-cpp).\n"
+    "  --count     Cuenta las derivaciones de cada longitud 1..N desde el símbolo de\n"
+    "              arranque (exactas, o módulo el valor dado en [2, 2^32)).\n"
+    "  --sample    Genera cadenas aleatorias de la longitud dada, uniformes por\n"
+    "              derivación (cada derivación es equiprobable), y las escribe en el\n"
+    "              fichero de salida, una por línea. Solo son uniformes como cadenas\n"
+    "              si la gramática no es ambigua; se avisa si se detecta ambigüedad.\n"
+    "  --forest    Muestra el bosque de análisis compartido (SPPF) de la cadena sobre\n"
+    "              las producciones de la gramática original.\n"
+    "  --check     Indica si el lenguaje es vacío y si es finito (con un ciclo testigo\n"
+    "              cuando es infinito).\n"
+    "  --stream    Convierte producción a producción con memoria acotada por la tabla\n"
+    "              de símbolos (no informa de alcanzables ni elimina repetidas).\n"
+    "  --pipeline  Convierte con tres hilos (lectura, conversión y escritura) unidos\n"
+    "              por colas; la salida es la misma que la de la conversión normal.\n"
+    "  --stats     Muestra el número de producciones y la memoria que ocupan como\n"
+    "              Production y como CompactRule (12 bytes por regla en FNC), y el\n"
+    "              grafo de componentes fuertemente conexas de la gramática de entrada.\n"
+    "  --alloc     Cuenta las reservas de memoria de cada fase de la conversión, en\n"
+    "              total y por regla de entrada. Solo en el ejecutable instrumentado\n"
+    "              (make alloc), como --alloc-growth.\n"
+    "  --alloc-growth\n"
+    "              Mide las dos gramáticas y divide la diferencia de reservas de cada\n"
+    "              fase entre la de reglas (coste por regla añadida, sin los costes\n"
+    "              fijos); falla si supera el límite de limites.txt (líneas \"fase\n"
+    "              máximo_por_regla\").\n"
+    "  --analyze   Muestra los conjuntos FIRST (& si el no terminal es anulable) y\n"
+    "              FOLLOW ($ para el fin de cadena) de la gramática de entrada.\n"
+    "  --lalr      Construye las tablas LALR(1) de la gramática de entrada, informa de\n"
+    "              los conflictos y analiza la cadena en tiempo lineal; si la gramática\n"
+    "              no es LALR(1), la analiza con GLR sobre las mismas tablas.\n"
+    "  --glr       Analiza la cadena con un reconocedor GLR sobre las tablas LALR(1),\n"
+    "              siguiendo a la vez todas las acciones de las celdas con conflictos.\n"
+    "  --valiant   Reconoce la cadena con el algoritmo de Valiant (productos de matrices\n"
+    "              de bits), opcionalmente con tablas de Cuatro Rusos.\n"
+    "  --crossover Compara CYK y Valiant con cadenas aleatorias de longitud creciente\n"
+    "              (8, 16, ... hasta longitud_max, 2048 por defecto).\n"
+    "  --online    Reconoce la cadena (o la entrada estándar) carácter a carácter e\n"
+    "              indica tras cada uno si el prefijo es viable y si es aceptado.\n"
+    "  --regular   Indica qué no terminales generan lenguajes regulares (subgramática\n"
+    "              lineal o sin autoincrustación) y, si lo es la gramática, la\n"
+    "              compila a un AFD mínimo y analiza la cadena con él.\n"
+    "  --mixed     Compila a AFD los no terminales regulares, los usa como hojas de\n"
+    "              CYK sobre el resto de la gramática y compara con CYK sobre la FNC\n"
+    "              completa.\n"
+    "  --serve     Atiende consultas por un socket Unix con gramáticas residentes en\n"
+    "              memoria, hasta recibir SIGINT o SIGTERM (protocolo en Server.h).\n"
+    "              El socket solo admite al usuario del servidor; convertir solo\n"
+    "              escribe en directorio_salida.\n"
+    "  --query     Envía una consulta al servidor: cargar (ruta .gra), convertir\n"
+    "              ([fichero en el directorio de salida]), pertenencia (cadena), alcanzables o reemplazar\n"
+    "              las reglas de A en la FNC (cada regla como \"a\" o \"B C\").\n";
+
+/**
+ * @brief Lee, valida y convierte a FNC la gramática del fichero input.
+ *
+ * Muestra los no terminales alcanzables desde el símbolo inicial y avisa de
+ * los no alcanzables antes de hacer la conversión.
+ *
+ * @param input Ruta del fichero .gra de entrada.
+ * @param g Gramática donde se deja el resultado en FNC.
+ * @param threads Hilos para la conversión (1 para la versión secuencial).
+ * @throws std::runtime_error En caso de error de lectura, validación o conversión.
+ */
+static void LoadAndConvert(const std::string& input, Grammar& g, unsigned threads = DefaultThreadCount()) {
+    // Leer gramática desde fichero de entrada
+    g.ReadFromFile(input);
+    // Validar formato de la gramática
+    g.ValidateFormat(threads);
+
+    // MODIF:
+    // Mostrar no terminales alcanzables desde el símbolo inicial y avisar si hay no alcanzables.
+    std::set<int> reachable = g.ReachableNonTerminals();
+    std::set<int> declared = g.DeclaredNonTerminals();
+
+    // Mostrar alcanzables
+    std::cout << "No terminales alcanzables desde " << g.StartSymbol() << ": ";
+    for (int id : reachable) std::cout << g.SymbolName(id) << ' ';
+    std::cout << std::endl;
+
+    // Si hay declarados que no están en alcanzables se avisa.
+    if (reachable.size() != declared.size()) {
+        std::cerr << "Aviso: existen no terminales no alcanzables: ";
+        for (int id : declared) {
+            if (reachable.find(id) == reachable.end()) std::cerr << g.SymbolName(id) << ' ';
+        }
+        std::cerr << std::endl;
+    }
+
+    // Comprobar precondiciones (sin producciones vacías ni unitarias)
+    g.CheckPreconditions();
+    // Aplicar el Algoritmo 1 para convertir a FNC
+    g.TransformToCNFParallel(threads);
+}
+
+/**
+ * @brief Escribe un conjunto FIRST o FOLLOW por línea: NOMBRE(A) = { ... }.
+ * @param name Nombre del conjunto.
+ * @param sets Conjuntos calculados.
+ * @param special Representación del símbolo especial ("&" o "$").
+ */
+static void PrintTerminalSets(const char* name, const TerminalSets& sets, const char* special) {
+    for (size_t a = 0; a < sets.nonterminals.size(); ++a) {
+        std::cout << name << "(" << sets.nonterminals[a] << ") = {";
+        for (size_t t = 0; t < sets.terminals.size(); ++t) {
+            if (sets.Has(a, t)) std::cout << ' ' << sets.terminals[t];
+        }
+        if (sets.Has(a, sets.Special())) std::cout << ' ' << special;
+        std::cout << " }\n";
+    }
+}
+
+/**
+ * @brief Busca una longitud pequeña en la que la gramática sea ambigua.
+ *
+ * Para cada longitud l <= max_len cuyas |T|^l cadenas caben en un
+ * presupuesto de trabajo (cadenas por regla binaria), compara las derivaciones N(S, l) con las cadenas
+ * distintas de longitud l que acepta CYK: si hay más derivaciones que
+ * cadenas, alguna cadena tiene dos derivaciones. No encontrar ninguna no
+ * prueba que la gramática no sea ambigua.
+ *
+ * @param index Índice de la gramática en FNC.
+ * @param max_len Longitud máxima a comprobar.
+ * @param derivations Derivaciones de la longitud encontrada (salida).
+ * @param strings Cadenas aceptadas de la longitud encontrada (salida).
+ * @return la primera longitud ambigua, o 0 si no se encuentra ninguna.
+ */
+static size_t FindAmbiguousLength(const CNFIndex& index, size_t max_len, BigUnsigned& derivations,
+                                  uint64_t& strings) {
+    // Cadenas enumeradas por longitud, a repartir entre las reglas (CYK recorre todas)
+    const uint64_t kWork = uint64_t{1} << 24;
+    const uint64_t budget = kWork / (index.BinaryRules().size() + 1);
+    std::set<char> terminal_set;
+    for (const auto& r : index.UnaryRules()) terminal_set.insert(r.terminal);
+    const std::vector<char> terminals(terminal_set.begin(), terminal_set.end());
+    if (terminals.empty()) return 0;
+
+    size_t limit = 0;
+    for (uint64_t total = terminals.size(); limit < max_len && total <= budget; total *= terminals.size()) ++limit;
+    if (limit == 0) return 0;
+
+    DerivationCounter counter(index, limit, 1);
+    CYKRecognizer cyk(index);
+    for (size_t len = 1; len <= limit; ++len) {
+        std::vector<size_t> digits(len, 0);
+        std::string word(len, terminals[0]);
+        uint64_t accepted = 0;
+        while (true) {
+            if (cyk.Accepts(word)) ++accepted;
+            size_t k = 0;
+            while (k < len && ++digits[k] == terminals.size()) {
+                digits[k] = 0;
+                word[k] = terminals[0];
+                ++k;
+            }
+            if (k == len) break;
+            word[k] = terminals[digits[k]];
+        }
+        const BigUnsigned& count = counter.Count(index.Start(), len);
+        if (BigUnsigned(accepted) < count) {
+            derivations = count;
+            strings = accepted;
+            return len;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reservas de memoria de una fase de la conversión.
+ */
+struct AllocPhase {
+    std::string name;
+    AllocCounts counts;
+};
+
+/**
+ * @brief Lanza si el ejecutable no cuenta las reservas.
+ * @param mode Modo que lo necesita (para el mensaje).
+ */
+static void RequireAllocCounting(const std::string& mode) {
+    if (!AllocCountingEnabled())
+        throw std::runtime_error(mode + " necesita el ejecutable instrumentado (make alloc).");
+}
+
+/**
+ * @brief Convierte input a FNC secuencialmente midiendo las reservas de cada
+ *        fase (lectura, validación, conversión y escritura).
+ * @param input Ruta del fichero .gra de entrada.
+ * @param output Ruta del fichero de salida.
+ * @param rules Número de reglas de entrada leídas (sin repetidas).
+ * @return reservas de cada fase, en orden.
+ */
+static std::vector<AllocPhase> MeasureConversion(const std::string& input, const std::string& output,
+                                                 size_t& rules) {
+    std::vector<AllocPhase> phases;
+    phases.reserve(4);
+    Grammar g;
+    auto measure = [&phases](const char* name, auto&& step) {
+        AllocCounts before = CurrentAllocCounts();
+        step();
+        AllocCounts after = CurrentAllocCounts();
+        AllocCounts delta;
+        delta.allocations = after.allocations - before.allocations;
+        delta.bytes = after.bytes - before.bytes;
+        phases.push_back(AllocPhase{name, delta});
+    };
+    measure("lectura", [&] { g.ReadFromFile(input); });
+    measure("validación", [&] {
+        g.ValidateFormat();
+        g.CheckPreconditions();
+    });
+    measure("conversión", [&] { g.TransformToCNF(); });
+    measure("escritura", [&] { g.WriteToFile(output); });
+    rules = g.SourceProductions().size();
+    return phases;
+}
+
+/**
+ * @brief Escribe una fila del informe de reservas: totales y por regla.
+ */
+static void PrintAllocRow(const std::string& name, const AllocCounts& c, double rules) {
+    std::cout << "  " << name << ": " << c.allocations << " reservas, " << c.bytes << " bytes ("
+              << static_cast<double>(c.allocations) / rules << " reservas y "
+              << static_cast<double>(c.bytes) / rules << " bytes por regla)\n";
+}
+
+/**
+ * @brief --emit-cpp: generar un reconocedor C++ especializado.
+ */
+static int RunEmitCpp(int /*argc*/, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    EmitCppRecognizer(CNFIndex::FromGrammar(g), argv[3]);
+    std::cout << "Reconocedor generado. Fichero de salida: " << argv[3] << "\n";
+    return 0;
+}
+
+/**
+ * @brief --bench: medir el reconocedor CYK genérico.
+ */
+static int RunBench(int argc, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    CYKRecognizer cyk(CNFIndex::FromGrammar(g));
+    std::string word = argv[3];
+    long reps = argc == 5 ? std::atol(argv[4]) : 1;
+    if (reps < 1) reps = 1;
+    bool accepted = false;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long r = 0; r < reps; ++r) accepted = cyk.Accepts(word);
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+    std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+    std::cout << "Tiempo medio: " << us << " us (" << reps << " repeticiones)\n";
+    return accepted ? 0 : 3;
+}
+
+/**
+ * @brief --count: contar derivaciones por longitud.
+ */
+static int RunCount(int argc, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    CNFIndex index = CNFIndex::FromGrammar(g);
+    long max_len = std::atol(argv[3]);
+    if (max_len < 1) throw std::runtime_error("La longitud máxima debe ser un entero positivo.");
+    uint64_t modulus = argc == 5 ? std::strtoull(argv[4], nullptr, 10) : 0;
+    DerivationCounter counter(index, static_cast<size_t>(max_len), DefaultThreadCount(), modulus);
+    for (long len = 1; len <= max_len; ++len) {
+        std::cout << "Longitud " << len << ": "
+                  << counter.Count(index.Start(), static_cast<size_t>(len)).ToString() << "\n";
+    }
+    return 0;
+}
+
+/**
+ * @brief --sample: generar cadenas aleatorias uniformes por derivación.
+ */
+static int RunSample(int argc, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    long count = std::atol(argv[3]);
+    long len = std::atol(argv[4]);
+    if (count < 0 || len < 1) throw std::runtime_error("Cantidad o longitud no válidas.");
+    CNFIndex index = CNFIndex::FromGrammar(g);
+    BigUnsigned derivations;
+    uint64_t strings = 0;
+    if (size_t amb = FindAmbiguousLength(index, static_cast<size_t>(len), derivations, strings)) {
+        std::cerr << "Aviso: la gramática es ambigua (longitud " << amb << ": " << derivations.ToString()
+                  << " derivaciones para " << strings << " cadenas); las cadenas son uniformes por "
+                  << "derivación, no por cadena." << std::endl;
+    }
+    unsigned threads = argc >= 7 ? static_cast<unsigned>(std::atol(argv[6])) : DefaultThreadCount();
+    uint64_t seed = argc == 8 ? std::strtoull(argv[7], nullptr, 10) : std::random_device{}();
+    UniformSampler sampler(index, static_cast<size_t>(len), DefaultThreadCount());
+    sampler.WriteSamples(argv[5], static_cast<size_t>(count), static_cast<size_t>(len), threads, seed);
+    std::cout << "Cadenas generadas. Fichero de salida: " << argv[5] << "\n";
+    return 0;
+}
+
+/**
+ * @brief --forest: mostrar el bosque de análisis de una cadena.
+ */
+static int RunForest(int /*argc*/, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    CYKRecognizer cyk(CNFIndex::FromGrammar(g));
+    ParseForest forest = ParseForest::Build(cyk, g, argv[3]);
+    forest.Print(std::cout, g);
+    return forest.Root() >= 0 ? 0 : 3;
+}
+
+/**
+ * @brief --check: comprobar si el lenguaje es vacío o finito.
+ */
+static int RunCheck(int /*argc*/, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    std::vector<std::string> cycle;
+    bool empty = g.IsEmpty();
+    bool finite = g.IsFinite(&cycle);
+    std::cout << "Lenguaje vacío: " << (empty ? "sí" : "no") << "\n";
+    std::cout << "Lenguaje finito: " << (finite ? "sí" : "no");
+    if (!finite) {
+        std::cout << " (ciclo:";
+        for (size_t i = 0; i < cycle.size(); ++i) std::cout << (i ? " -> " : " ") << cycle[i];
+        std::cout << ")";
+    }
+    std::cout << "\n";
+    return 0;
+}
+
+/**
+ * @brief --analyze: conjuntos FIRST y FOLLOW de la gramática de entrada.
+ */
+static int RunAnalyze(int /*argc*/, char* argv[]) {
+    Grammar g;
+    g.ReadFromFile(argv[2]);
+    g.ValidateFormat(DefaultThreadCount());
+    PrintTerminalSets("FIRST", g.FirstSets(), "&");
+    PrintTerminalSets("FOLLOW", g.FollowSets(), "$");
+    return 0;
+}
+
+/**
+ * @brief --lalr: analizador LALR(1) (GLR si la gramática tiene conflictos).
+ */
+static int RunLALR(int /*argc*/, char* argv[]) {
+    Grammar g;
+    g.ReadFromFile(argv[2]);
+    g.ValidateFormat(DefaultThreadCount());
+    LALRTable table = LALRTable::Build(g);
+    std::cout << "LALR(1): " << table.NumStates() << " estados, " << table.NumRules() << " reglas, "
+              << table.Conflicts().size() << " conflictos\n";
+    std::cout << "Tablas: " << table.TableBytes() << " bytes comprimidas (" << table.DenseBytes()
+              << " sin comprimir)\n";
+    for (const auto& c : table.Conflicts()) std::cout << "  " << c << "\n";
+    std::string word = argv[3];
+    bool accepted = false;
+    if (table.IsLALR1()) {
+        accepted = LRParser(table).Accepts(word);
+    } else {
+        // GLR usa las mismas tablas y, a diferencia de CYK sobre la FNC,
+        // admite producciones vacías y unitarias en la gramática de entrada
+        std::cout << "La gramática no es LALR(1); se usa GLR.\n";
+        accepted = GLRParser(table).Accepts(word);
+    }
+    std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+    return accepted ? 0 : 3;
+}
+
+/**
+ * @brief --glr: reconocedor GLR (admite gramáticas ambiguas).
+ */
+static int RunGLR(int argc, char* argv[]) {
+    Grammar g;
+    g.ReadFromFile(argv[2]);
+    g.ValidateFormat(DefaultThreadCount());
+    LALRTable table = LALRTable::Build(g);
+    GLRParser glr(table);
+    std::string word = argv[3];
+    long reps = argc == 5 ? std::atol(argv[4]) : 1;
+    if (reps < 1) reps = 1;
+    bool accepted = false;
+    GLRStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long r = 0; r < reps; ++r) accepted = glr.Accepts(word, &stats);
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+    std::cout << "GLR: " << table.NumStates() << " estados, " << table.Conflicts().size() << " conflictos\n";
+    std::cout << "Pila: " << stats.nodes << " nodos, " << stats.edges << " aristas\n";
+    std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+    std::cout << "Tiempo medio: " << us << " us (" << reps << " repeticiones)\n";
+    return accepted ? 0 : 3;
+}
+
+/**
+ * @brief --valiant: reconocedor de Valiant sobre la FNC.
+ */
+static int RunValiant(int argc, char* argv[]) {
+    bool four_russians = std::string(argv[argc - 1]) == "--four-russians";
+    if (four_russians) --argc;
+    if (argc < 4 || argc > 5) throw std::runtime_error("Argumentos no válidos para --valiant.");
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    ValiantRecognizer valiant(CNFIndex::FromGrammar(g), four_russians);
+    std::string word = argv[3];
+    long reps = argc == 5 ? std::atol(argv[4]) : 1;
+    if (reps < 1) reps = 1;
+    bool accepted = false;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long r = 0; r < reps; ++r) accepted = valiant.Accepts(word);
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+    std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+    std::cout << "Tiempo medio: " << us << " us (" << reps << " repeticiones)\n";
+    return accepted ? 0 : 3;
+}
+
+/**
+ * @brief --crossover: punto de cruce entre CYK y Valiant.
+ */
+static int RunCrossover(int argc, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    CNFIndex index = CNFIndex::FromGrammar(g);
+    long max_len = argc == 4 ? std::atol(argv[3]) : 2048;
+    if (max_len < 1) throw std::runtime_error("La longitud máxima debe ser un entero positivo.");
+    std::string alphabet;
+    for (const auto& r : index.UnaryRules()) {
+        if (alphabet.find(r.terminal) == std::string::npos) alphabet += r.terminal;
+    }
+    if (alphabet.empty()) throw std::runtime_error("La gramática no tiene terminales.");
+    CYKRecognizer cyk(index);
+    ValiantRecognizer valiant(index), russians(index, true);
+    // Tiempo en milisegundos de una llamada a Accepts
+    auto time = [](auto& recognizer, const std::string& word, bool& accepted) {
+        auto t0 = std::chrono::steady_clock::now();
+        accepted = recognizer.Accepts(word);
+        auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    long crossover = -1, crossover_4r = -1;
+    std::cout << "Longitud  CYK (ms)  Valiant (ms)  Valiant+4R (ms)\n";
+    for (long len = 8; len <= max_len; len *= 2) {
+        std::string word;
+        for (long i = 0; i < len; ++i) word += alphabet[pick(rng)];
+        bool a = false, b = false, c = false;
+        double t_cyk = time(cyk, word, a);
+        double t_valiant = time(valiant, word, b);
+        double t_russians = time(russians, word, c);
+        if (a != b || a != c) {
+            throw std::runtime_error("CYK y Valiant no coinciden en la longitud " + std::to_string(len) + ".");
+        }
+        std::cout << len << "  " << t_cyk << "  " << t_valiant << "  " << t_russians << "\n";
+        if (crossover < 0 && t_valiant < t_cyk) crossover = len;
+        if (crossover_4r < 0 && t_russians < t_cyk) crossover_4r = len;
+    }
+    auto report = [](const char* name, long len) {
+        std::cout << name << ": ";
+        if (len < 0) std::cout << "no supera a CYK en las longitudes probadas\n";
+        else std::cout << "supera a CYK desde la longitud " << len << "\n";
+    };
+    report("Valiant", crossover);
+    report("Valiant+4R", crossover_4r);
+    return 0;
+}
+
+/**
+ * @brief --online: reconocimiento incremental, carácter a carácter.
+ */
+static int RunOnline(int argc, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    OnlineRecognizer online(CNFIndex::FromGrammar(g));
+    std::string word = argc == 4 ? argv[3] : "";
+    OnlineStep step{false, true};
+    auto report = [&](char c) {
+        step = online.Push(c);
+        std::cout << "Prefijo " << online.Length() << " ('" << c << "'): "
+                  << (step.viable ? "viable" : "no viable") << ", "
+                  << (step.accepted ? "aceptado" : "no aceptado") << std::endl;
+    };
+    if (argc == 4) {
+        for (char c : word) report(c);
+    } else {
+        // Sin cadena se leen los caracteres de la entrada estándar según llegan
+        for (char c; std::cin.get(c);) {
+            if (c != '\n' && c != '\r') report(c);
+        }
+    }
+    std::cout << "Resultado: " << (step.accepted ? "aceptada" : "rechazada") << "\n";
+    return step.accepted ? 0 : 3;
+}
+
+/**
+ * @brief --regular: compilación de gramáticas lineales a AFD.
+ */
+static int RunRegular(int argc, char* argv[]) {
+    Grammar g;
+    g.ReadFromFile(argv[2]);
+    g.ValidateFormat(DefaultThreadCount());
+    std::vector<Linearity> linear = g.LinearNonTerminals();
+    std::vector<Linearity> forms = g.RegularNonTerminals();
+    size_t i = 0;
+    for (const auto& nt : g.NonTerminals()) {
+        const char* kind = "no regular";
+        if (linear[i] == Linearity::kRight) kind = "lineal por la derecha";
+        else if (linear[i] == Linearity::kLeft) kind = "lineal por la izquierda";
+        else if (forms[i] != Linearity::kNone) kind = "regular (no autoincrustado)";
+        std::cout << nt << ": " << kind << "\n";
+        ++i;
+    }
+    bool regular = forms[std::distance(g.NonTerminals().begin(), g.NonTerminals().find(g.StartSymbol()))] !=
+                   Linearity::kNone;
+    bool accepted = false;
+    if (regular) {
+        DFA dfa = DFA::FromGrammar(g, g.StartSymbol());
+        std::cout << "AFN: " << dfa.Stats().nfa_states << " estados, AFD: " << dfa.Stats().dfa_states
+                  << " estados, AFD mínimo: " << dfa.Stats().min_states << " estados\n";
+        if (argc == 4) accepted = dfa.Accepts(argv[3]);
+    } else {
+        std::cout << "La gramática no es regular";
+        if (argc == 4) {
+            std::cout << "; se usa CYK.\n";
+            Grammar cnf;
+            LoadAndConvert(argv[2], cnf);
+            accepted = CYKRecognizer(CNFIndex::FromGrammar(cnf)).Accepts(argv[3]);
+        } else {
+            std::cout << ".\n";
+        }
+    }
+    if (argc == 3) return 0;
+    std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+    return accepted ? 0 : 3;
+}
+
+/**
+ * @brief --mixed: reconocedor mixto: AFD para los no terminales regulares y CYK para el resto.
+ */
+static int RunMixed(int argc, char* argv[]) {
+    Grammar g;
+    g.ReadFromFile(argv[2]);
+    g.ValidateFormat(DefaultThreadCount());
+    g.CheckPreconditions();
+    MixedRecognizer mixed(g);
+    Grammar full = g;
+    full.TransformToCNF();
+    CNFIndex full_index = CNFIndex::FromGrammar(full);
+    CYKRecognizer cyk(full_index);
+    const MixedStats& stats = mixed.Stats();
+    std::cout << "No terminales regulares:";
+    for (const auto& nt : mixed.RegularNames()) std::cout << ' ' << nt;
+    std::cout << "\nNúcleo: " << stats.core_binary_rules << " reglas binarias (FNC completa: "
+              << full_index.BinaryRules().size() << "), " << stats.leaves << " hojas con AFD ("
+              << stats.dfa_states << " estados)\n";
+    std::string word = argv[3];
+    long reps = argc == 5 ? std::atol(argv[4]) : 1;
+    if (reps < 1) reps = 1;
+    bool accepted = false, expected = false;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long r = 0; r < reps; ++r) accepted = mixed.Accepts(word);
+    auto t1 = std::chrono::steady_clock::now();
+    for (long r = 0; r < reps; ++r) expected = cyk.Accepts(word);
+    auto t2 = std::chrono::steady_clock::now();
+    if (accepted != expected) throw std::runtime_error("El reconocedor mixto y CYK no coinciden.");
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+    double us_cyk = std::chrono::duration<double, std::micro>(t2 - t1).count() / reps;
+    std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+    std::cout << "Tiempo medio: " << us << " us (CYK sobre la FNC completa: " << us_cyk << " us, " << reps
+              << " repeticiones)\n";
+    return accepted ? 0 : 3;
+}
+
+/**
+ * @brief --serve: servidor de consultas por socket Unix.
+ */
+static int RunServe(int argc, char* argv[]) {
+    long workers = argc >= 4 ? std::atol(argv[3]) : static_cast<long>(DefaultThreadCount());
+    if (workers < 1) throw std::runtime_error("El número de hilos debe ser un entero positivo.");
+    GrammarRegistry registry(argc == 5 ? argv[4] : "");
+    std::cout << "Escuchando en " << argv[2] << " con " << workers << " hilos." << std::endl;
+    ServeUnixSocket(argv[2], registry, static_cast<unsigned>(workers));
+    std::cout << "Servidor detenido.\n";
+    return 0;
+}
+
+/**
+ * @brief --query: cliente del servidor.
+ */
+static int RunQuery(int argc, char* argv[]) {
+    const std::string op = argv[3];
+    std::vector<std::string> fields(argv + 4, argv + argc);
+    ServerOp code;
+    if (op == "load" && argc == 6) code = ServerOp::kLoad;
+    else if (op == "convert" && argc <= 6) code = ServerOp::kConvert;
+    else if (op == "member" && argc == 6) code = ServerOp::kMember;
+    else if (op == "reachable" && argc == 5) code = ServerOp::kReachable;
+    else if (op == "replace" && argc >= 6) code = ServerOp::kReplace;
+    else throw std::runtime_error("Consulta no válida: " + op + ".");
+    std::string reply = QueryUnixSocket(argv[2], EncodeRequest(code, fields));
+    if (reply.empty()) throw std::runtime_error("Respuesta vacía del servidor.");
+    std::string body = reply.substr(1);
+    if (static_cast<ServerStatus>(reply[0]) != ServerStatus::kOk) throw std::runtime_error(body);
+    if ((code == ServerOp::kConvert || code == ServerOp::kReplace) && body.size() == 4) {
+        uint32_t count = 0;
+        for (int i = 3; i >= 0; --i) count = count << 8 | static_cast<unsigned char>(body[i]);
+        std::cout << (code == ServerOp::kConvert ? "Conversión completada (" : "Reglas sustituidas (")
+                  << count << " producciones).\n";
+    } else if (code == ServerOp::kMember) {
+        bool accepted = body == std::string(1, 1);
+        std::cout << "Resultado: " << (accepted ? "aceptada" : "rechazada") << "\n";
+        return accepted ? 0 : 3;
+    } else if (code == ServerOp::kReachable) {
+        std::cout << "No terminales alcanzables: " << body << "\n";
+    } else {
+        std::cout << "Gramática cargada.\n";
+    }
+    return 0;
+}
+
+/**
+ * @brief --stats: estadísticas de la gramática y de su representación en memoria.
+ */
+static int RunStats(int /*argc*/, char* argv[]) {
+    Grammar g;
+    LoadAndConvert(argv[2], g);
+    auto report = [](const char* title, const std::vector<Production>& rules) {
+        CompactRuleSet compact = CompactRuleSet::FromProductions(rules);
+        size_t n = rules.empty() ? 1 : rules.size();
+        size_t before = CompactRuleSet::ProductionBytes(rules);
+        std::cout << title << ": " << rules.size() << " producciones\n"
+                  << "  Production:  " << before << " bytes (" << before / n << " por regla)\n"
+                  << "  CompactRule: " << compact.RuleBytes() << " bytes (" << compact.RuleBytes() / n
+                  << " por regla) + " << compact.NameBytes() << " bytes de nombres\n";
+    };
+    report("Gramática de entrada", g.SourceProductions());
+    report("Gramática en FNC", g.Productions());
+
+    // DAG de componentes de la gramática de entrada, dependencias primero
+    Grammar source;
+    source.ReadFromFile(argv[2]);
+    ComponentGraph dag = source.Components();
+    const unsigned threads = DefaultThreadCount();
+    size_t recursive = 0, edges = 0, depth = 0;
+    std::vector<size_t> level(dag.Size(), 1);
+    for (size_t c = 0; c < dag.Size(); ++c) {
+        recursive += dag.recursive[c];
+        edges += dag.uses[c].size();
+        for (int d : dag.uses[c]) level[c] = std::max(level[c], level[d] + 1);
+        depth = std::max(depth, level[c]);
+    }
+    std::cout << "Componentes fuertemente conexas: " << dag.Size() << " (" << recursive << " recursivas), "
+              << edges << " dependencias, " << depth << " niveles\n";
+    const size_t shown = std::min<size_t>(dag.Size(), 64);
+    for (size_t c = 0; c < shown; ++c) {
+        std::cout << "  C" << c << ":";
+        for (int a : dag.members[c]) std::cout << ' ' << dag.nonterminals[a];
+        if (dag.recursive[c]) std::cout << " (recursiva)";
+        if (!dag.uses[c].empty()) {
+            std::cout << " ->";
+            for (int d : dag.uses[c]) std::cout << " C" << d;
+        }
+        std::cout << '\n';
+    }
+    if (shown < dag.Size()) std::cout << "  ... (" << dag.Size() - shown << " más)\n";
+    std::cout << "Generadores: " << source.GeneratingNonTerminals(threads).size() << " de "
+              << dag.nonterminals.size() << ", anulables: " << source.NullableNonTerminals(threads).size()
+              << " (por componentes, " << threads << " hilos)\n";
+    return 0;
+}
+
+/**
+ * @brief --alloc: reservas de memoria por fase de la conversión secuencial.
+ */
+static int RunAlloc(int /*argc*/, char* argv[]) {
+    RequireAllocCounting("--alloc");
+    size_t rules = 0;
+    std::vector<AllocPhase> phases = MeasureConversion(argv[2], argv[3], rules);
+    std::cout << "Reservas por fase (" << rules << " reglas de entrada):\n" << std::fixed
+              << std::setprecision(2);
+    const double per = static_cast<double>(std::max<size_t>(rules, 1));
+    AllocCounts total;
+    for (const auto& p : phases) {
+        PrintAllocRow(p.name, p.counts, per);
+        total.allocations += p.counts.allocations;
+        total.bytes += p.counts.bytes;
+    }
+    PrintAllocRow("total", total, per);
+    return 0;
+}
+
+/**
+ * @brief --alloc-growth: reservas por regla añadida: diferencia entre dos gramáticas de distinto tamaño.
+ */
+static int RunAllocGrowth(int /*argc*/, char* argv[]) {
+    RequireAllocCounting("--alloc-growth");
+    size_t small_rules = 0, large_rules = 0;
+    std::vector<AllocPhase> small = MeasureConversion(argv[2], "/dev/null", small_rules);
+    std::vector<AllocPhase> large = MeasureConversion(argv[3], "/dev/null", large_rules);
+    if (large_rules <= small_rules)
+        throw std::runtime_error("--alloc-growth: la segunda gramática debe tener más reglas que la primera.");
+    const double added = static_cast<double>(large_rules - small_rules);
+    std::cout << "Reservas por regla añadida (" << small_rules << " -> " << large_rules << " reglas):\n"
+              << std::fixed << std::setprecision(2);
+    std::vector<std::pair<std::string, double>> marginal;
+    for (size_t i = 0; i < large.size(); ++i) {
+        AllocCounts delta;
+        delta.allocations = large[i].counts.allocations - std::min(large[i].counts.allocations,
+                                                                  small[i].counts.allocations);
+        delta.bytes = large[i].counts.bytes - std::min(large[i].counts.bytes, small[i].counts.bytes);
+        PrintAllocRow(large[i].name, delta, added);
+        marginal.emplace_back(large[i].name, static_cast<double>(delta.allocations) / added);
+    }
+
+    std::ifstream limits(argv[4]);
+    if (!limits) throw std::runtime_error("No se pudo abrir el fichero de límites: " + std::string(argv[4]));
+    bool exceeded = false;
+    std::string line;
+    while (std::getline(limits, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name;
+        double limit = 0;
+        if (!(fields >> name >> limit)) throw std::runtime_error("Línea de límites no válida: " + line);
+        auto it = std::find_if(marginal.begin(), marginal.end(),
+                               [&](const std::pair<std::string, double>& m) { return m.first == name; });
+        if (it == marginal.end()) throw std::runtime_error("Fase desconocida en los límites: " + name);
+        if (it->second > limit + 1e-9) {
+            std::cerr << "Límite superado en " << name << ": " << it->second
+                      << " reservas por regla añadida (máximo " << limit << ")\n";
+            exceeded = true;
+        }
+    }
+    if (exceeded) return 4;
+    std::cout << "Reservas por regla añadida dentro de los límites de " << argv[4] << "\n";
+    return 0;
+}
+
+/**
+ * @brief --stream: conversión en flujo, sin cargar las producciones en memoria.
+ */
+static int RunStream(int /*argc*/, char* argv[]) {
+    Grammar g;
+    size_t written = g.ConvertStreaming(argv[2], argv[3]);
+    std::cout << "Conversión completada (" << written << " producciones). Fichero de salida: "
+              << argv[3] << "\n";
+    return 0;
+}
+
+/**
+ * @brief --pipeline: conversión en tres etapas solapadas (lectura, conversión, escritura).
+ */
+static int RunPipeline(int /*argc*/, char* argv[]) {
+    Grammar g;
+    size_t written = g.ConvertPipelined(argv[2], argv[3]);
+    std::cout << "Conversión completada (" << written << " producciones). Fichero de salida: "
+              << argv[3] << "\n";
+    return 0;
+}
+
+/**
+ * @brief Conversión normal a FNC, con las opciones --minimize, --group-terminals
+ *        y --threads delante de input.gra output.gra.
+ */
+static int RunConvert(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    // Opciones de la conversión normal
+    bool minimize = false;
+    bool group_terminals = false;
+    unsigned threads = DefaultThreadCount();
+    while (mode == "--minimize" || mode == "--group-terminals" || (mode == "--threads" && argc > 2)) {
+        int used = 1;
+        if (mode == "--minimize") {
+            minimize = true;
+        } else if (mode == "--group-terminals") {
+            group_terminals = true;
+        } else {
+            long t = std::atol(argv[2]);
+            if (t < 1) throw std::runtime_error("El número de hilos debe ser un entero positivo.");
+            threads = static_cast<unsigned>(t);
+            used = 2;
+        }
+        argc -= used;
+        argv += used;
+        mode = argc > 1 ? argv[1] : "";
+    }
+
+    // Si no se han pasado 2 argumentos, mostrar uso y salir
+    if (argc != 3 || mode.rfind("--", 0) == 0) {
+        std::cerr << "Modo de empleo: ./Grammar2CNF input.gra output.gra\n";
+        std::cerr << "Pruebe 'Grammar2CNF --help' para más información.\n";
+        return 1;
+    }
+
+    // Obtener nombres de ficheros de entrada y salida
+    std::string input = argv[1]; // fichero .gra de entrada
+    std::string output = argv[2]; // fichero .gra de salida
+
+    // Crear gramática, leerla, validarla y convertirla a FNC
+    Grammar g;
+    g.SetTerminalGrouping(group_terminals);
+    LoadAndConvert(input, g, threads);
+    // Fusionar no terminales equivalentes si se ha pedido
+    if (minimize) {
+        MergeStats stats = g.MergeEquivalentNonTerminals();
+        std::cout << "Minimización: " << stats.nonterminals_removed << " no terminales y "
+                  << stats.productions_removed << " producciones eliminados.\n";
+    }
+    // Escribir gramática resultante en fichero de salida
+    g.WriteToFile(output);
+
+    // Informar de que se ha completado la conversión correctamente
+    std::cout << "Conversión completada. Fichero de salida: " << output << "\n";
+    return 0;
+}
+
+/**
+ * @brief Modo con opción propia: nombre, número de argumentos admitido
+ *        (argc, incluido el nombre del programa) y función que lo ejecuta.
+ */
+struct Mode {
+    const char* name;
+    int min_argc;
+    int max_argc;
+    int (*run)(int argc, char* argv[]);
+};
+
+// Modos con opción propia; cualquier otra invocación es la conversión normal
+static const Mode kModes[] = {
+    {"--emit-cpp", 4, 4, RunEmitCpp},
+    {"--bench", 4, 5, RunBench},
+    {"--count", 4, 5, RunCount},
+    {"--sample", 6, 8, RunSample},
+    {"--forest", 4, 4, RunForest},
+    {"--check", 3, 3, RunCheck},
+    {"--analyze", 3, 3, RunAnalyze},
+    {"--lalr", 4, 4, RunLALR},
+    {"--glr", 4, 5, RunGLR},
+    {"--valiant", 4, 6, RunValiant},
+    {"--crossover", 3, 4, RunCrossover},
+    {"--online", 3, 4, RunOnline},
+    {"--regular", 3, 4, RunRegular},
+    {"--mixed", 4, 5, RunMixed},
+    {"--serve", 3, 5, RunServe},
+    {"--query", 5, INT_MAX, RunQuery},
+    {"--stats", 3, 3, RunStats},
+    {"--alloc", 4, 4, RunAlloc},
+    {"--alloc-growth", 5, 5, RunAllocGrowth},
+    {"--stream", 4, 4, RunStream},
+    {"--pipeline", 4, 4, RunPipeline},
+};
 
 /**
  * @brief Función principal.
@@ -56,12 +966,19 @@ static const char* kUsage =
  *  2) Leer la gramática desde el fichero input.gra.
  *  3) Validar formato y precondiciones (sin epsilon ni unitarias).
  *  4) Aplicar el Algoritmo 1 para convertir a FNC.
- *  5) Escribir la gramática resultante en output.gra.
+ *  5) Escribir la gramática resultante en output.gra, o bien generar el
+ *     reconocedor C++ (--emit-cpp), medir el reconocedor genérico (--bench)
+ *     contar derivaciones por longitud (--count), generar cadenas
+ *     aleatorias uniformes por derivación (--sample), mostrar el SPPF de una cadena (--forest)
+ *     o comprobar si el lenguaje es vacío o finito (--check).
  *
  * Códigos de salida:
  *  0 - ejecución correcta
  *  1 - uso incorrecto / argumentos
  *  2 - error durante la lectura/validación/transformación
+ *  3 - (--bench, --forest, --lalr, --glr, --valiant, --online, --regular, --mixed,
+ *      --query member) la cadena no pertenece al lenguaje
+ *  4 - (--alloc-growth) alguna fase supera su límite de reservas por regla añadida
  */
 int main(int argc, char* argv[]) {
     // Comprobar argumentos
@@ -74,57 +991,19 @@ int main(int argc, char* argv[]) {
                 return 0;
             }
         }
-        // Si no se han pasado 2 argumentos, mostrar uso y salir
-        if (argc != 3) {
-            std::cerr << "Modo de empleo: ./Grammar2CNF input.gra output.gra\n";
-            std::cerr << "Pruebe 'Grammar2CNF --help' para más información.\n";
-            return 1;
-        }
 
-        // Obtener nombres de ficheros de entrada y salida
-        std::string input = argv[1]; // fichero .gra de entrada
-        std::string output = argv[2]; // fichero .gra de salida
-
-        // Crear gramática
-        Grammar g;
-        // Leer gramática desde fichero de entrada
-        g.ReadFromFile(input);
-        // Validar formato de la gramática
-        g.ValidateFormat();
+        std::string mode = argc > 1 ? argv[1] : "";
 
-        // MODIF:
-        // Mostrar no terminales alcanzables desde el símbolo inicial y avisar si hay no alcanzables.
-        std::set<char> reachable = g.ReachableNonTerminals();
-        std::set<char> declared = g.DeclaredNonTerminals();
-
-        // Mostrar alcanzables
-        std::cout << "No terminales alcanzables desde " << g.StartSymbol() << ": ";
-        for (char c : reachable) std::cout << c << ' ';
-        std::cout << std::endl;
-
-        // Si hay declarados que no están en alcanzables se avisa.
-        if (reachable.size() != declared.size()) {
-            std::cerr << "Aviso: existen no terminales no alcanzables: ";
-            for (char c : declared) {
-                if (reachable.find(c) == reachable.end()) std::cerr << c << ' ';
-            }
-            std::cerr << std::endl;
+        // Ejecutar el modo pedido si el número de argumentos es el suyo
+        for (const Mode& m : kModes) {
+            if (mode == m.name && argc >= m.min_argc && argc <= m.max_argc) return m.run(argc, argv);
         }
 
-        // Comprobar precondiciones (sin producciones vacías ni unitarias)
-        g.CheckPreconditions();
-        // Aplicar el Algoritmo 1 para convertir a FNC
-        g.TransformToCNF();
-        // Escribir gramática resultante en fichero de salida
-        g.WriteToFile(output);
-
-        // Informar de que se ha completado la conversión correctamente
-        std::cout << "Conversión completada. Fichero de salida: " << output << "\n";
-        return 0;
-
+        // En otro caso, conversión normal (o modo de empleo si los argumentos no encajan)
+        return RunConvert(argc, argv);
     } catch (const std::exception& e) {
         // Capturar cualquier excepción lanzada y mostrar el mensaje de error
         std::cerr << "Error: " << e.what() << "\n";
         return 2;
     }
-}
\ No newline at end of file
+}